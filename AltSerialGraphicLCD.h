@@ -66,7 +66,8 @@
 #define GLCD_MODE_OR               ((uint8_t)(0x02))
 // XOR mode (screen ^ pixel)
 #define GLCD_MODE_XOR              ((uint8_t)(0x04))
-// AND mode (screen & ~pixel)
+// AND mode (screen & ~pixel). Older firmware drew NAND as XOR, use
+// GLCD_MODE_XOR to toggle pixels.
 #define GLCD_MODE_NAND             ((uint8_t)(0x06))
 // Perform a fill
 #define GLCD_MODE_FILL             ((uint8_t)(0x08))
@@ -78,11 +79,28 @@
 // Font type definitions
 #define GLCD_FONT_NORMAL           0    /* Normal size font */
 #define GLCD_FONT_TOM_THUMB        1    /* Small size font */
+#define GLCD_FONT_LARGE            2    /* Large numeric font (FONT_LARGE) */
+#define GLCD_FONT_SEVEN_SEGMENT    3    /* Seven segment numeric font (FONT_LARGE) */
 
 // Font positioning
 #define GLCD_FONT_CENTER           0    /* Center justification */
 #define GLCD_FONT_RIGHT            1    /* Right justification */
 
+// Page flip flags
+#define GLCD_PAGE_FLIP_COPY        0x01 /* Copy the new front page to the back */
+
+// Screen restore flags
+#define GLCD_SCREEN_RESTORE_RELEASE 0x01 /* Release the slot after restore */
+
+// Text layer flags
+#define GLCD_TEXT_LAYER_ON         0x01 /* Enable the text layer */
+#define GLCD_TEXT_LAYER_ATTRIBUTE  0x02 /* Attribute mode, graphics hidden */
+#define GLCD_TEXT_LAYER_BLINK      0x04 /* Blink text (attribute mode) */
+
+// Text window flags
+#define GLCD_WINDOW_SCROLL         0x01 /* Scroll, otherwise wrap to the top */
+#define GLCD_WINDOW_WRAP           0x02 /* Wrap, otherwise discard long lines */
+
 /////////////////////////////////////////////////////////////////////////////
 // Serial command definitions
 /////////////////////////////////////////////////////////////////////////////
@@ -130,6 +148,33 @@
 #define GLCD_CMDX_SET_XY_OFFSET    ((uint8_t)(0x58))
 #define GLCD_CMDX_SET_XY_STRING    ((uint8_t)(0x59))
 #define GLCD_CMDX_DRAW_POLYGON     ((uint8_t)(0x5a))
+#define GLCD_CMDX_LIST_BEGIN       ((uint8_t)(0x5b)) /* DISPLAY_LIST */
+#define GLCD_CMDX_LIST_CALL        ((uint8_t)(0x5c)) /* DISPLAY_LIST */
+#define GLCD_CMDX_LIST_END         ((uint8_t)(0x5d)) /* DISPLAY_LIST */
+#define GLCD_CMDX_LIST_DEFINE      ((uint8_t)(0x5e)) /* DISPLAY_LIST */
+#define GLCD_CMDX_LIST_EXEC        ((uint8_t)(0x5f)) /* DISPLAY_LIST */
+#define GLCD_CMDX_LIST_REPEAT      ((uint8_t)(0x60)) /* DISPLAY_LIST */
+#define GLCD_CMDX_PAGE_MODE        ((uint8_t)(0x61))
+#define GLCD_CMDX_PAGE_FLIP        ((uint8_t)(0x62))
+#define GLCD_CMDX_SCREEN_SAVE      ((uint8_t)(0x63)) /* T6963_STORE */
+#define GLCD_CMDX_SCREEN_RESTORE   ((uint8_t)(0x64)) /* T6963_STORE */
+#define GLCD_CMDX_TEXT_LAYER       ((uint8_t)(0x65)) /* T6963_TEXT_LAYER */
+#define GLCD_CMDX_HBITBLT          ((uint8_t)(0x66))
+#define GLCD_CMDX_WINDOW_DEFINE    ((uint8_t)(0x67)) /* FONT_WINDOW */
+#define GLCD_CMDX_WINDOW_SELECT    ((uint8_t)(0x68)) /* FONT_WINDOW */
+#define GLCD_CMDX_DRAW_CLIP        ((uint8_t)(0x69))
+#define GLCD_CMDX_DRAW_ORIGIN      ((uint8_t)(0x6a))
+#define GLCD_CMDX_COPY_RECT        ((uint8_t)(0x6b))
+#define GLCD_CMDX_DRAW_SCALE       ((uint8_t)(0x6c)) /* DRAW_SCALE */
+
+// Display list template argument escape. Follow with the argument number
+// (0..7) to substitute an argument or with a second escape for 0xff.
+#define GLCD_LIST_ESCAPE           ((uint8_t)(0xff))
+
+// Sprite identity flags. Add to the sprite number to select the store. The
+// display memory sprites are only in firmware built with T6963_STORE.
+#define GLCD_SPRITE_VRAM           0x40 /* Display memory sprite 0..63 (160x128 only) */
+#define GLCD_SPRITE_EEPROM         0x80 /* EEPROM sprite */
 
 //////////////////////////////////////////////////////////////////////////////
 // Argument definitions
@@ -639,6 +684,65 @@ public:
         this->putcmd (GLCD_CMD_DRAW_MODE, 1, mode);
     };
 
+    //////////////////////////////////////////////////////////////////////////
+    /// Set the clip rectangle of the drawing in screen coordinates. Nothing
+    /// is drawn outside of the rectangle, except for a GLCD_SPRITE_VRAM
+    /// sprite which is only limited to the screen. Use (0, 0, 255, 255)
+    /// for the whole screen.
+    ///
+    /// @param [in] x1 The left x-coordinate.
+    /// @param [in] y1 The top y-coordinate.
+    /// @param [in] x2 The right x-coordinate.
+    /// @param [in] y2 The bottom y-coordinate.
+    ///
+    void setClip (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+    {
+        this->putcmd (GLCD_CMDX_DRAW_CLIP, 4, x1, y1, x2, y2);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Set the origin that is added to the coordinates of the drawing
+    /// commands. Text is positioned by its window and is not moved.
+    ///
+    /// @param [in] x The x-coordinate of the origin.
+    /// @param [in] y The y-coordinate of the origin.
+    ///
+    void setOrigin (uint8_t x, uint8_t y)
+    {
+        this->putcmd (GLCD_CMDX_DRAW_ORIGIN, 2, x, y);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Set the integer scale of the bitblts, sprites and text that are
+    /// drawn on the graphics, each pixel is drawn as a square of scale x
+    /// scale pixels. Lines, shapes and VRAM sprites are not scaled. The
+    /// scale is only in firmware built with DRAW_SCALE.
+    ///
+    /// @param [in] scale The scale 1..4.
+    ///
+    void setScale (uint8_t scale)
+    {
+        this->putcmd (GLCD_CMDX_DRAW_SCALE, 1, scale);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Copy a rectangle of the screen to another position, the rectangles
+    /// may overlap. The pixels are merged with the drawing mode set with
+    /// drawMode(), the destination is clipped to the clip rectangle.
+    ///
+    /// @param [in] sx The left x-coordinate of the source.
+    /// @param [in] sy The top y-coordinate of the source.
+    /// @param [in] width The width of the rectangle.
+    /// @param [in] height The height of the rectangle.
+    /// @param [in] dx The left x-coordinate of the destination.
+    /// @param [in] dy The top y-coordinate of the destination.
+    ///
+    void copyRect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                   uint8_t dx, uint8_t dy)
+    {
+        this->putcmd (GLCD_CMDX_COPY_RECT, 6, sx, sy, width, height, dx, dy);
+    };
+
     //////////////////////////////////////////////////////////////////////////
     /// Draws a line.
     ///
@@ -971,12 +1075,51 @@ public:
                       x, y, mode, length, sprite);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    /// Draw a row organised image in the screen from memory. Each row is
+    /// (width + 7) / 8 bytes with the most significant bit on the left, as
+    /// in a PBM file. This is the native format of the 160x128 display.
+    ///
+    /// @param [in] x The top left x-coordinate.
+    /// @param [in] y The top left y-coordinate.
+    /// @param [in] mode The drawing mode of the image.
+    /// @param [in] width The width of the image in pixels.
+    /// @param [in] height The height of the image in pixels.
+    /// @param [in] pixels A pointer to the row data in memory.
+    ///
+    void hbitblt (uint8_t x, uint8_t y, uint8_t mode,
+                  uint8_t width, uint8_t height, uint8_t *pixels)
+    {
+        this->putcmd (GLCD_CMDX_HBITBLT, GLCD_ARG_SIZEOF|5, x, y, mode,
+                      width, height, ((width + 7) >> 3) * height, pixels);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Draw a row organised image in the screen from Flash memory.
+    ///
+    /// @param [in] x The top left x-coordinate.
+    /// @param [in] y The top left y-coordinate.
+    /// @param [in] mode The drawing mode of the image.
+    /// @param [in] width The width of the image in pixels.
+    /// @param [in] height The height of the image in pixels.
+    /// @param [in] pixels A pointer to the row data in flash memory.
+    ///
+    void hbitblt_P (uint8_t x, uint8_t y, uint8_t mode,
+                    uint8_t width, uint8_t height, const uint8_t *pixels)
+    {
+        this->putcmd (GLCD_CMDX_HBITBLT, GLCD_ARG_PROGMEM|GLCD_ARG_SIZEOF|5,
+                      x, y, mode, width, height, ((width + 7) >> 3) * height,
+                      pixels);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     /// Draw a polygon with coordinates defined in memory.
     ///
     /// @param [in] mode The drawing mode of the line.
     /// @param [in] xylist A pointer to a list of (x,y) coordinate pairs. The
-    ///                    end of the list is terminated with y|0x80.
+    ///                    end of the list is terminated with y|0x80. A
+    ///                    GLCD_MODE_FILL polygon may have at most 32
+    ///                    vertices, a fill with more is not drawn.
     ///
     void drawPolygon (uint8_t mode, uint8_t *xylist)
     {
@@ -988,7 +1131,9 @@ public:
     ///
     /// @param [in] mode The drawing mode of the line.
     /// @param [in] xylist A pointer to a list of (x,y) coordinate pairs. The
-    ///                    end of the list is terminated with y|0x80.
+    ///                    end of the list is terminated with y|0x80. A
+    ///                    GLCD_MODE_FILL polygon may have at most 32
+    ///                    vertices, a fill with more is not drawn.
     ///
     void drawPolygon_P (uint8_t mode, const uint8_t *xylist)
     {
@@ -1000,7 +1145,9 @@ public:
     /// Draw a polygon with coordinates defined in memory.
     ///
     /// @param [in] xylist A pointer to a list of (x,y) coordinate pairs. The
-    ///                    end of the list is terminated with y|0x80.
+    ///                    end of the list is terminated with y|0x80. A
+    ///                    GLCD_MODE_FILL polygon may have at most 32
+    ///                    vertices, a fill with more is not drawn.
     ///
     void drawPolygon (uint8_t *xylist)
     {
@@ -1011,7 +1158,9 @@ public:
     /// Draw a polygon with coordinates defined in Flash memory.
     ///
     /// @param [in] xylist A pointer to a list of (x,y) coordinate pairs. The
-    ///                    end of the list is terminated with y|0x80.
+    ///                    end of the list is terminated with y|0x80. A
+    ///                    GLCD_MODE_FILL polygon may have at most 32
+    ///                    vertices, a fill with more is not drawn.
     ///
     void drawPolygon_P (const uint8_t *xylist)
     {
@@ -1143,6 +1292,193 @@ public:
         this->putcmd (GLCD_CMD_FONT_FACE, 1, charset);
     };
 
+    //////////////////////////////////////////////////////////////////////////
+    /// Start recording a display list. The commands that follow are drawn
+    /// as normal and are also recorded by the display until endList().
+    /// The display lists are only in firmware built with DISPLAY_LIST.
+    ///
+    /// @param [in] id The identity of the list. Set the top bit (0x80) to
+    ///                store the list in EEPROM where supported.
+    ///
+    void beginList (uint8_t id)
+    {
+        this->putcmd (GLCD_CMDX_LIST_BEGIN, 1, id);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Finish recording a display list.
+    ///
+    void endList ()
+    {
+        this->putcmd (GLCD_CMDX_LIST_END, 0);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Replay a display list that has been recorded on the display.
+    ///
+    /// @param [in] id The identity of the list.
+    ///
+    void callList (uint8_t id)
+    {
+        this->putcmd (GLCD_CMDX_LIST_CALL, 1, id);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Define a display list from memory without drawing it. The list may
+    /// contain GLCD_LIST_ESCAPE sequences to make a template.
+    /// A GLCD_LIST_ESCAPE at the very end of the list is ignored. The
+    /// display lists are only in firmware built with DISPLAY_LIST.
+    ///
+    /// @param [in] id The identity of the list.
+    /// @param [in] length The length of the list in bytes.
+    /// @param [in] data A pointer to the list in memory.
+    ///
+    void defineList (uint8_t id, uint8_t length, uint8_t *data)
+    {
+        this->putcmd (GLCD_CMDX_LIST_DEFINE,
+                      GLCD_ARG_SIZEOF|2, id, length, length, data);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Define a display list from flash memory without drawing it.
+    ///
+    /// @param [in] id The identity of the list.
+    /// @param [in] length The length of the list in bytes.
+    /// @param [in] data A pointer to the list in flash memory.
+    ///
+    void defineList_P (uint8_t id, uint8_t length, const uint8_t *data)
+    {
+        this->putcmd (GLCD_CMDX_LIST_DEFINE,
+                      GLCD_ARG_PROGMEM|GLCD_ARG_SIZEOF|2, id, length,
+                      length, data);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Replay a display list template with arguments.
+    ///
+    /// @param [in] id The identity of the list.
+    /// @param [in] argc The number of arguments (max 8).
+    /// @param [in] args The arguments to substitute.
+    ///
+    void execList (uint8_t id, uint8_t argc, uint8_t *args)
+    {
+        this->putcmd (GLCD_CMDX_LIST_EXEC,
+                      GLCD_ARG_SIZEOF|2, id, argc, argc, args);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Replay a display list template a number of times. After each replay
+    /// the steps are added to the arguments.
+    ///
+    /// @param [in] id The identity of the list.
+    /// @param [in] count The number of times to replay the list.
+    /// @param [in] argc The number of arguments and steps (max 8).
+    /// @param [in] args The initial arguments to substitute.
+    /// @param [in] steps The signed step to add to each argument.
+    ///
+    void repeatList (uint8_t id, uint8_t count, uint8_t argc,
+                     uint8_t *args, int8_t *steps)
+    {
+        this->putcmd (GLCD_CMDX_LIST_REPEAT,
+                      GLCD_ARG_SIZEOF|3, id, count, argc, argc, args);
+        this->write ((uint8_t *) steps, argc);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Enable or disable page mode on the 160x128 display. In page mode all
+    /// drawing is performed on a hidden back page until pageFlip().
+    ///
+    /// @param [in] enable true to enable page mode.
+    ///
+    void pageMode (bool enable)
+    {
+        this->putcmd (GLCD_CMDX_PAGE_MODE, 1, enable ? 1 : 0);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Display the back page in page mode.
+    ///
+    /// @param [in] flags GLCD_PAGE_FLIP_COPY to copy the newly displayed
+    ///                   page to the back page, otherwise 0.
+    ///
+    void pageFlip (uint8_t flags)
+    {
+        this->putcmd (GLCD_CMDX_PAGE_FLIP, 1, flags);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Save a rectangle of the 160x128 display to a slot, e.g. before a
+    /// dialog is drawn over it. Use (0, 0, 255, 255) for the whole screen.
+    /// The slots are only in firmware built with T6963_STORE.
+    ///
+    /// @param [in] slot The slot to save to (0..3).
+    /// @param [in] x1 The left x-coordinate.
+    /// @param [in] y1 The top y-coordinate.
+    /// @param [in] x2 The right x-coordinate.
+    /// @param [in] y2 The bottom y-coordinate.
+    ///
+    void saveScreen (uint8_t slot, uint8_t x1, uint8_t y1,
+                     uint8_t x2, uint8_t y2)
+    {
+        this->putcmd (GLCD_CMDX_SCREEN_SAVE, 5, slot, x1, y1, x2, y2);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Restore a saved rectangle to the place it was saved from.
+    ///
+    /// @param [in] slot The slot to restore from (0..3).
+    /// @param [in] flags GLCD_SCREEN_RESTORE_RELEASE to free the slot
+    ///                   otherwise 0.
+    ///
+    void restoreScreen (uint8_t slot, uint8_t flags)
+    {
+        this->putcmd (GLCD_CMDX_SCREEN_RESTORE, 2, slot, flags);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Switch text output to the hardware text layer of the 160x128
+    /// display. Characters use fixed 8x8 cells (20 columns by 16 rows).
+    /// The text layer is only in firmware built with T6963_TEXT_LAYER.
+    ///
+    /// @param [in] flags GLCD_TEXT_LAYER_ON to enable the layer, optionally
+    ///                   with GLCD_TEXT_LAYER_ATTRIBUTE and
+    ///                   GLCD_TEXT_LAYER_BLINK; 0 to disable it.
+    ///
+    void textLayer (uint8_t flags)
+    {
+        this->putcmd (GLCD_CMDX_TEXT_LAYER, 1, flags);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Define a text window. The window takes the current font and mode and
+    /// its cursor is moved to the top left, text positions are relative to
+    /// the window. Use (0, 0, 255, 255) for the whole screen. The windows
+    /// are only in firmware built with FONT_WINDOW.
+    ///
+    /// @param [in] id The window (0..3).
+    /// @param [in] x1 The left x-coordinate.
+    /// @param [in] y1 The top y-coordinate.
+    /// @param [in] x2 The right x-coordinate.
+    /// @param [in] y2 The bottom y-coordinate.
+    /// @param [in] flags GLCD_WINDOW_SCROLL and GLCD_WINDOW_WRAP.
+    ///
+    void defineWindow (uint8_t id, uint8_t x1, uint8_t y1,
+                       uint8_t x2, uint8_t y2, uint8_t flags)
+    {
+        this->putcmd (GLCD_CMDX_WINDOW_DEFINE, 6, id, x1, y1, x2, y2, flags);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// Select the text window that text is printed in. Each window keeps its
+    /// own cursor, font and mode.
+    ///
+    /// @param [in] id The window (0..3).
+    ///
+    void selectWindow (uint8_t id)
+    {
+        this->putcmd (GLCD_CMDX_WINDOW_SELECT, 1, id);
+    };
+
     //////////////////////////////////////////////////////////////////////////
     /// Set the value of a EEPROM location. The value is stored in EEPROM
     ///
@@ -375,6 +375,21 @@ glcdDrawLine (void)
         lcd.drawLine (xmax-1, ymax-2, xmax/2, ii, GLCD_MODE_NORMAL);
     }
     countdown();
+
+    // The scale does not apply to lines. Draw the same lines unscaled and
+    // at scale 3 in XOR mode, the screen is clear below the title when the
+    // lines match, a missing end point is left as a dot.
+    lcd.clearScreen ();
+    centreString_P (0, title_name);
+    lcd.drawMode (GLCD_MODE_XOR);
+    for (ii = 12; ii < ymax; ii += 6)
+        lcd.drawLine (1, 12, xmax - 2, ii);
+    lcd.setScale (3);
+    for (ii = 12; ii < ymax; ii += 6)
+        lcd.drawLine (1, 12, xmax - 2, ii);
+    lcd.setScale (1);
+    lcd.drawMode (GLCD_MODE_NORMAL);
+    countdown();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -56,6 +56,47 @@ uint8_t line_buffer [LINE_BUFFER_MAX];
 // The current draw mode.
 uint8_t drawing_mode;
 
+#ifdef DRAW_SCALE
+// The integer scale of bitblts, sprites and fonts.
+uint8_t drawing_scale;
+#endif
+
+// The KS0108B line span. The pixels of a line that fall in one page are
+// collected as column masks at the top of the draw_buffer and merged with
+// the screen in a single pass when the line leaves the page.
+#define LINE_SPAN_MAX      64           /* Maximum columns in a span */
+#define line_span          (&draw_buffer [SCREEN_MAX_WIDTH - LINE_SPAN_MAX])
+
+static uint8_t span_x;                  /* Column of the first pixel */
+static uint8_t span_y;                  /* Top row of the page */
+static uint8_t span_width;              /* Number of columns, 0 empty */
+static int8_t span_xinc;                /* Direction of the line in x */
+
+// The polygon fill. The vertices are held in the draw_buffer above the
+// masks that are composed at the start, followed by the sorted crossings of
+// the current row.
+#define POLYGON_MAX        32           /* Maximum vertices of a fill */
+#define polygon_vertex     (&draw_buffer [SCREEN_MAX_WIDTH - (3 * POLYGON_MAX)])
+#define polygon_cross      (&draw_buffer [SCREEN_MAX_WIDTH - POLYGON_MAX])
+
+// The scaled bitblt. Each band of 8 rows is expanded into tiles that are
+// drawn with the driver bitblt, clear of the rows the driver builds at the
+// start of the buffer. A band from the serial is collected above the tile
+// and a bitmap in memory lives above the scale source.
+#define SCALE_TILE         32           /* Maximum columns in a tile */
+#define scale_tile         (&draw_buffer [48])
+#define scale_source       (&draw_buffer [80])
+
+// The drawing view. The origin is added to the coordinates of the graphics
+// commands and every span is clipped to the clip rectangle, in screen
+// coordinates, before it is passed to the driver.
+static uint8_t clip_x0;                 /* Left column of the clip */
+static uint8_t clip_y0;                 /* Top row of the clip */
+static uint8_t clip_x1;                 /* Right column of the clip */
+static uint8_t clip_y1;                 /* Bottom row of the clip */
+static uint8_t origin_x;                /* Column of the origin */
+static uint8_t origin_y;                /* Row of the origin */
+
 /////////////////////////////////////////////////////////////////////////////
 /// Change the current drawing mode.
 ///
@@ -67,6 +108,442 @@ draw_mode (uint8_t mode)
     drawing_mode = mode;
 }
 
+#ifdef DRAW_SCALE
+/////////////////////////////////////////////////////////////////////////////
+/// Change the integer scale of the bitblts, sprites and fonts. Each pixel of
+/// the bitmap is drawn as a square of scale x scale pixels.
+///
+/// @param [in] scale The new scale 1..SCALE_MAX, limited to the range.
+///
+void
+draw_scale (uint8_t scale)
+{
+    if (scale < 1)
+        scale = 1;
+    else if (scale > SCALE_MAX)
+        scale = SCALE_MAX;
+    drawing_scale = scale;
+
+    // The character cell follows the scale.
+    font_cell ();
+}
+#endif /* DRAW_SCALE */
+
+/////////////////////////////////////////////////////////////////////////////
+/// Set the clip rectangle of the drawing. Nothing is drawn outside of the
+/// rectangle, the rectangle is limited to the screen so 0, 0, 255, 255
+/// restores the whole screen.
+///
+/// @param [in] x0 The left column.
+/// @param [in] y0 The top row.
+/// @param [in] x1 The right column.
+/// @param [in] y1 The bottom row.
+///
+void
+draw_clip (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    if (x0 > x1)
+        swap_bytes (x0, x1);
+    if (y0 > y1)
+        swap_bytes (y0, y1);
+    if (x1 >= x_dim)
+        x1 = x_dim - 1;
+    if (y1 >= y_dim)
+        y1 = y_dim - 1;
+
+    // A rectangle off the screen is empty, the start is after the end.
+    clip_x0 = x0;
+    clip_y0 = y0;
+    clip_x1 = x1;
+    clip_y1 = y1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Set the origin of the drawing. The origin is added to the coordinates
+/// of the graphics commands, the text is positioned by its window.
+///
+/// @param [in] x The column of the origin.
+/// @param [in] y The row of the origin.
+///
+void
+draw_origin (uint8_t x, uint8_t y)
+{
+    origin_x = x;
+    origin_y = y;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Move a point by the origin for the drawing that the driver performs
+/// directly, such as a VRAM sprite. The clip rectangle is not applied.
+///
+/// @param [in,out] x The column of the point.
+/// @param [in,out] y The row of the point.
+///
+/// @return Non-zero if the moved point is within the coordinate range.
+///
+uint8_t
+draw_at_origin (uint8_t *x, uint8_t *y)
+{
+    int sx = *x + origin_x;             // The point on the screen
+    int sy = *y + origin_y;
+
+    *x = sx;
+    *y = sy;
+    return (sx <= 0xff) && (sy <= 0xff);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Fill a box clipped to the clip rectangle. The pattern is rotated so that
+/// the rows below the clip keep their place in the pattern.
+///
+/// @param [in] x1 The left column.
+/// @param [in] y1 The top row.
+/// @param [in] x2 The right column.
+/// @param [in] y2 The bottom row.
+/// @param [in] mode The resolved driver mode, MODE_FILL is implied.
+/// @param [in] data The vertical fill pattern.
+///
+static void
+clip_box (int x1, int y1, int x2, int y2, uint8_t mode, uint8_t data)
+{
+    if (x1 < clip_x0)
+        x1 = clip_x0;
+    if (x2 > clip_x1)
+        x2 = clip_x1;
+    if (y2 > clip_y1)
+        y2 = clip_y1;
+    if (y1 < clip_y0)
+    {
+        uint8_t shift = (clip_y0 - y1) & 0x7;
+
+        data = (data >> shift) | (data << (8 - shift));
+        y1 = clip_y0;
+    }
+    if ((x1 > x2) || (y1 > y2))
+        return;
+
+    lcd_vbitblt (x1, y1, x2 - x1 + 1, y2 - y1 + 1, mode | MODE_FILL, &data);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Test if a bitmap is within the clip rectangle and may be drawn by the
+/// driver. The drivers discard the columns and rows beyond the right and the
+/// bottom of the screen so the bitmap may cross the edges of the clip that
+/// are on those of the screen.
+///
+/// @param [in] x The left column.
+/// @param [in] y The top row.
+/// @param [in] right The right column.
+/// @param [in] bottom The bottom row.
+///
+/// @return Non-zero if the bitmap is within the clip.
+///
+static uint8_t
+clip_inside (int x, int y, int right, int bottom)
+{
+    return ((x >= clip_x0) && (x <= clip_x1) &&
+            (y >= clip_y0) && (y <= clip_y1) &&
+            ((right <= clip_x1) || (clip_x1 == x_dim - 1)) &&
+            ((bottom <= clip_y1) || (clip_y1 == y_dim - 1)));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Merge a row of column masks with a page of the screen. The pixels are
+/// written with an OR unless a combinational mode is given so the set bits
+/// of the masks are drawn and the clear bits leave the screen unchanged.
+///
+/// @param [in] x The first column.
+/// @param [in] y The top row of the page.
+/// @param [in] width The number of columns.
+/// @param [in] mode The drawing mode.
+/// @param [in] data The column masks.
+///
+static void
+mask_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t mode, uint8_t *data)
+{
+    mode |= MODE_MERGE;
+    if ((mode & MODE_OP_MASK) == 0)
+        mode |= MODE_OR;
+    lcd_vbitblt (x, y, width, 8, mode, data);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Merge a row of byte masks with a row of the screen, see mask_vbitblt().
+///
+/// @param [in] x The first column, a multiple of 8.
+/// @param [in] y The row.
+/// @param [in] width The number of columns, a multiple of 8.
+/// @param [in] mode The drawing mode.
+/// @param [in] data The byte masks.
+///
+static void
+mask_hbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t mode, uint8_t *data)
+{
+    mode |= MODE_MERGE;
+    if ((mode & MODE_OP_MASK) == 0)
+        mode |= MODE_OR;
+    lcd_hbitblt (x, y, width, 1, mode, data);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Merge the column masks composed at the start of the draw_buffer with a
+/// page of the screen. Each run of columns with pixels is merged in turn,
+/// the run is copied down the draw_buffer by vbitblt which is safe as the
+/// data is always ahead of the copy.
+///
+/// @param [in] x The column of the first mask.
+/// @param [in] y The top row of the page.
+/// @param [in] width The number of masks, at most 64.
+/// @param [in] mode The drawing mode.
+///
+static void
+mask_flush (uint8_t x, uint8_t y, uint8_t width, uint8_t mode)
+{
+    uint8_t ii;
+    int8_t start;                       // The start of a run of masks
+
+    start = -1;
+    for (ii = 0; ii <= width; ii++)
+    {
+        if ((ii < width) && (draw_buffer [ii] != 0))
+        {
+            if (start < 0)
+                start = ii;
+        }
+        else if (start >= 0)
+        {
+            mask_vbitblt (x + start, y, ii - start, mode, &draw_buffer [start]);
+            start = -1;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Merge the line span with the screen.
+///
+/// @param [in] mode The drawing mode of the line.
+///
+static void
+span_flush (uint8_t mode)
+{
+    if (span_width != 0)
+    {
+        // A line drawn right to left fills the span from the end.
+        if (span_xinc > 0)
+            mask_vbitblt (span_x, span_y, span_width, mode, line_span);
+        else
+            mask_vbitblt (span_x - span_width + 1, span_y, span_width, mode,
+                          &line_span [LINE_SPAN_MAX - span_width]);
+        span_width = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Add a pixel to the line span. The span is merged with the screen first
+/// when the pixel is in another page or is too far from the first column.
+/// The pixels must be added in the order that the line is drawn.
+///
+/// @param [in] x The x-coordinate of the pixel.
+/// @param [in] y The y-coordinate of the pixel.
+/// @param [in] mode The drawing mode of the line.
+///
+static void
+span_pixel (uint8_t x, uint8_t y, uint8_t mode)
+{
+    uint8_t offset;                     // Column offset into the span.
+
+    offset = (span_xinc > 0) ? x - span_x : span_x - x;
+    if ((span_width == 0) || ((y & 0xf8) != span_y) || (offset >= LINE_SPAN_MAX))
+    {
+        span_flush (mode);
+        span_x = x;
+        span_y = y & 0xf8;
+        offset = 0;
+        memset (line_span, 0, LINE_SPAN_MAX);
+    }
+
+    if (offset >= span_width)
+        span_width = offset + 1;
+    if (span_xinc < 0)
+        offset = (LINE_SPAN_MAX - 1) - offset;
+    line_span [offset] |= 1 << (y & 0x7);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a horizontal line clipped to the clip rectangle.
+///
+/// @param [in] x0 The first x-coordinate.
+/// @param [in] y0 The y-coordinate.
+/// @param [in] x1 The last x-coordinate.
+/// @param [in] s_r The drawing mode.
+///
+static void
+clip_hline (int x0, int y0, int x1, uint8_t s_r)
+{
+    // Make sure y is in the clip
+    if ((y0 >= clip_y0) && (y0 <= clip_y1))
+    {
+        // Swap the word if in the incorrect order.
+        if (x0 > x1)
+        {
+            int temp;
+
+            temp = x0;
+            x0 = x1;
+            x1 = temp;
+        }
+
+        // Clip the end points and discard a line outside of the clip.
+        if (x1 > clip_x1)
+            x1 = clip_x1;
+        if (x0 < clip_x0)
+            x0 = clip_x0;
+        if (x0 <= x1)
+            draw_hline (x0, y0, x1, s_r);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a vertical line clipped to the clip rectangle.
+///
+/// @param [in] x0 The x-coordinate.
+/// @param [in] y0 The first y-coordinate.
+/// @param [in] y1 The last y-coordinate.
+/// @param [in] s_r The drawing mode.
+///
+static void
+clip_vline (int x0, int y0, int y1, uint8_t s_r)
+{
+    // Make sure x is in the clip
+    if ((x0 >= clip_x0) && (x0 <= clip_x1))
+    {
+        // Swap the word if in the incorrect order.
+        if (y0 > y1)
+        {
+            int temp;
+
+            temp = y0;
+            y0 = y1;
+            y1 = temp;
+        }
+
+        // Clip the end points and discard a line outside of the clip.
+        if (y1 > clip_y1)
+            y1 = clip_y1;
+        if (y0 < clip_y0)
+            y0 = clip_y0;
+        if (y0 <= y1)
+            draw_vline (x0, y0, y1, s_r);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a horizontal run of a line. The run is moved by the origin and
+/// clipped as a whole, the KS0108B collects the run in the line span and the
+/// T6963 already writes a run as row bytes.
+///
+/// @param [in] x The first x-coordinate.
+/// @param [in] y The y-coordinate.
+/// @param [in] x1 The last x-coordinate.
+/// @param [in] mode The drawing mode of the line.
+///
+static void
+line_hline (uint8_t x, uint8_t y, uint8_t x1, uint8_t mode)
+{
+    int sx = x + origin_x;              // The run on the screen
+    int sx1 = x1 + origin_x;
+    int sy = y + origin_y;
+
+    if (is_large ())
+        clip_hline (sx, sy, sx1, mode);
+    else if ((sy >= clip_y0) && (sy <= clip_y1))
+    {
+        // Clip the run keeping the direction that the line is drawn in.
+        if (sx <= sx1)
+        {
+            if (sx < clip_x0)
+                sx = clip_x0;
+            if (sx1 > clip_x1)
+                sx1 = clip_x1;
+            if (sx > sx1)
+                return;
+        }
+        else
+        {
+            if (sx > clip_x1)
+                sx = clip_x1;
+            if (sx1 < clip_x0)
+                sx1 = clip_x0;
+            if (sx < sx1)
+                return;
+        }
+
+        for (;;)
+        {
+            span_pixel (sx, sy, mode);
+            if (sx == sx1)
+                break;
+            if (sx < sx1)
+                sx++;
+            else
+                sx--;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a vertical run of a line. The run is moved by the origin and
+/// clipped as a whole, the KS0108B collects the run in the line span.
+///
+/// @param [in] x The x-coordinate.
+/// @param [in] y The first y-coordinate.
+/// @param [in] y1 The last y-coordinate.
+/// @param [in] mode The drawing mode of the line.
+///
+static void
+line_vline (uint8_t x, uint8_t y, uint8_t y1, uint8_t mode)
+{
+    int sx = x + origin_x;              // The run on the screen
+    int sy = y + origin_y;
+    int sy1 = y1 + origin_y;
+
+    if (is_large ())
+        clip_vline (sx, sy, sy1, mode);
+    else if ((sx >= clip_x0) && (sx <= clip_x1))
+    {
+        // Clip the run keeping the direction that the line is drawn in.
+        if (sy <= sy1)
+        {
+            if (sy < clip_y0)
+                sy = clip_y0;
+            if (sy1 > clip_y1)
+                sy1 = clip_y1;
+            if (sy > sy1)
+                return;
+        }
+        else
+        {
+            if (sy > clip_y1)
+                sy = clip_y1;
+            if (sy1 < clip_y0)
+                sy1 = clip_y0;
+            if (sy < sy1)
+                return;
+        }
+
+        for (;;)
+        {
+            span_pixel (sx, sy, mode);
+            if (sy == sy1)
+                break;
+            if (sy < sy1)
+                sy++;
+            else
+                sy--;
+        }
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /// line performs a Bresenhams line draw. This uses the buffer storage
 /// so cannot be used with any operation that uses the buffer.
@@ -120,6 +597,7 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
         yinc = -1;
         deltay = y - y1;
     }
+    span_xinc = xinc;
 
     // There is at least one x-value for every y-value. Handle the incrementing
     // and decremening separately.
@@ -143,7 +621,7 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
             numpixels++;
 
         xstart = x;
-        written = numpixels - 1;
+        written = (numpixels != 0);     // Nothing pending for an empty line
 
         // Write all of the pixels
         while (--numpixels >= 0)
@@ -152,7 +630,7 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
             if (numerator >= denominator) // Check if numerator >= denominator
             {
                 numerator -= denominator; // Calculate the new numerator value
-                draw_hline (xstart, y, x, ps_r);
+                line_hline (xstart, y, x, ps_r);
 
                 y += yinc;              // Change the y as appropriate
                 x += xinc;              // Increment x as required.
@@ -166,7 +644,7 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
 
         // Make sure that any line fragment has been flushed.
         if (written != 0)
-            draw_hline (xstart, y, x - xinc, ps_r);
+            line_hline (xstart, y, x - xinc, ps_r);
 
     }
     // There is at least one y-value for every x-value
@@ -190,7 +668,7 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
             numpixels++;
 
         ystart = y;
-        written = numpixels - 1;
+        written = (numpixels != 0);     // Nothing pending for an empty line
 
         // Write all of the pixels
         while (--numpixels >= 0)
@@ -200,7 +678,7 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
             if (numerator >= denominator) // Check if numerator >= denominator
             {
                 numerator -= denominator; // Calculate the new numerator value
-                draw_vline (x, ystart, y, ps_r);
+                line_vline (x, ystart, y, ps_r);
 
                 x += xinc;              // Change the x as appropriate
                 y += yinc;
@@ -215,8 +693,11 @@ draw_line (uint8_t x, uint8_t y, uint8_t x1, uint8_t y1, uint8_t s_r)
 
         // Ensure that all pixels are written
         if (written != 0)
-            draw_vline (x, ystart, y - yinc, ps_r);
+            line_vline (x, ystart, y - yinc, ps_r);
     }
+
+    // Merge any pixels left in the line span.
+    span_flush (ps_r);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -263,7 +744,7 @@ draw_lines (uint8_t s_r, uint8_t x, uint8_t y, uint8_t *data)
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// Draw a pixel. Confirm that the pixel is within bounds and then draw it.
+/// Draw a pixel. Confirm that the pixel is within the clip and then draw it.
 ///
 /// @param [in] x The x-coordinate
 /// @param [in] y The y-coordinate
@@ -271,76 +752,197 @@ draw_lines (uint8_t s_r, uint8_t x, uint8_t y, uint8_t *data)
 void
 draw_pixel (uint8_t x, uint8_t y, uint8_t s_r)
 {
-    if (x_valid(x) && y_valid(y))
+    int sx = x + origin_x;              // The pixel on the screen
+    int sy = y + origin_y;
+
+    if ((sx >= clip_x0) && (sx <= clip_x1) && (sy >= clip_y0) && (sy <= clip_y1))
     {
         // Compute the current mode based on the reverse preference.
         s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~MODE_NORMAL_MASK);
-        lcd_set_pixel (x, y, s_r);
+        lcd_set_pixel (sx, sy, s_r);
     }
 }
 
+// The KS0108B circle. The half height of each column of the circle is held
+// in the line span and each page row is composed from the heights as column
+// masks at the start of the draw_buffer.
+#define CIRCLE_CHUNK       64           /* Columns composed at a time */
+#define circle_height      line_span
+
+/////////////////////////////////////////////////////////////////////////////
+/// Raise the half height of the circle columns up to a distance from the
+/// centre.
+///
+/// @param [in] dx The distance of the last column from the centre.
+/// @param [in] dy The half height of the columns.
+///
 static void
-clip_hline (int x0, int y0, int x1, uint8_t s_r)
+circle_extent (uint8_t dx, uint8_t dy)
 {
-    // Make sure y is on screen
-    if (y_valid (y0))
+    // The heights never increase away from the centre so stop at the
+    // first column that is already high enough.
+    while (circle_height [dx] < dy)
     {
-        // Swap the word if in the incorrect order.
-        if (x0 > x1)
-        {
-            int temp;
+        circle_height [dx] = dy;
+        if (dx-- == 0)
+            break;
+    }
+}
 
-            temp = x0;
-            x0 = x1;
-            x1 = temp;
-        }
+/////////////////////////////////////////////////////////////////////////////
+/// Get the distance of a column from the centre of a circle. The columns of
+/// the gap are all at the centre.
+///
+/// @param [in] x The column.
+/// @param [in] x0 The left hand centre column.
+/// @param [in] xgap The gap between the left and right hand centres.
+///
+/// @return The distance from the centre.
+///
+static int
+circle_dx (int x, int x0, uint8_t xgap)
+{
+    if (x < x0)
+        return x0 - x;
+    x -= x0 + xgap;
+    return (x > 0) ? x : 0;
+}
 
-        // Ensure end point is on screen
-        if (x1 >= 0)
-        {
-            // Ensure start point is on screen */
-            if (x0 < x_dim)
-            {
-                // Ensure endpoint is not off screen
-                if (x1 >= x_dim)
-                    x1 = x_dim - 1;     // Clip end point to screen.
-                if (x0 < 0)
-                    x0 = 0;             // Clip start point to screen.
-                draw_hline (x0, y0, x1, s_r);
-            }
-        }
-    }
+/////////////////////////////////////////////////////////////////////////////
+/// Get the column mask of a run of rows within a page.
+///
+/// @param [in] y The first row of the run.
+/// @param [in] y1 The last row of the run.
+/// @param [in] py The top row of the page.
+///
+/// @return The column mask of the rows in the page.
+///
+static uint8_t
+page_mask (int y, int y1, int py)
+{
+    uint8_t mask = 0xff;
+
+    y -= py;
+    y1 -= py;
+    if ((y1 < 0) || (y > 7))
+        return 0;
+    if (y > 0)
+        mask <<= y;
+    if (y1 < 7)
+        mask &= 0xff >> (7 - y1);
+    return mask;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a circle or rounded box on the KS0108B. The midpoint algorithm
+/// computes the half height of each column and each page row is then merged
+/// with the screen once. The outline is the set of pixels of the fill that
+/// have a neighbour outside of the fill so no pixel is drawn twice.
+///
+/// @param [in] xin The left hand centre x-coordinate on the screen.
+/// @param [in] yin The top centre y-coordinate on the screen.
+/// @param [in] xgap The gap between the left and right hand centres.
+/// @param [in] ygap The gap between the top and bottom centres.
+/// @param [in] r The radius, less than LINE_SPAN_MAX.
+/// @param [in] s_r The drawing mode.
+///
 static void
-clip_vline (int x0, int y0, int y1, uint8_t s_r)
+span_circle (int xin, int yin, uint8_t xgap, uint8_t ygap, uint8_t r, uint8_t s_r)
 {
-    // Make sure y is on screen
-    if (x_valid (x0))
+    int f = 1 - r;
+    int ddF_x = 1;
+    int ddF_y = -2 * r;
+    int x = 0;
+    int y = r;
+    int x0 = xin;
+    int y0 = yin;
+    int xend;
+    int py;
+    int pend;
+
+    // Compute the half heights of the columns.
+    memset (circle_height, 0, r + 1);
+    while (x < y)
     {
-        // Swap the word if in the incorrect order.
-        if (y0 > y1)
+        if (f >= 0)
         {
-            int temp;
-
-            temp = y0;
-            y0 = y1;
-            y1 = temp;
+            circle_extent (x, y);
+            circle_extent (y, x);
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
         }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+    }
+    if (x == y)
+        circle_extent (x, y);
+
+    // Clip the columns and the pages to the clip rectangle.
+    x = x0 - r;
+    if (x < clip_x0)
+        x = clip_x0;
+    xend = x0 + xgap + r;
+    if (xend > clip_x1)
+        xend = clip_x1;
+    py = y0 - r;
+    if (py < clip_y0)
+        py = clip_y0;
+    pend = y0 + ygap + r;
+    if (pend > clip_y1)
+        pend = clip_y1;
+
+    // Compose each page row in chunks.
+    for (py &= ~0x7; py <= pend; py += 8)
+    {
+        uint8_t rows;                   // The rows of the page in the clip
+        int xx;
 
-        // Ensure end point is on screen
-        if (y1 >= 0)
+        rows = page_mask (clip_y0, clip_y1, py);
+
+        for (xx = x; xx <= xend; xx += CIRCLE_CHUNK)
         {
-            // Ensure start point is on screen */
-            if (y0 < y_dim)
+            uint8_t width;              // The columns in the chunk
+            uint8_t ii;
+
+            width = CIRCLE_CHUNK;
+            if (xend - xx < CIRCLE_CHUNK)
+                width = xend - xx + 1;
+
+            for (ii = 0; ii < width; ii++)
             {
-                // Ensure endpoint is not off screen
-                if (y1 >= y_dim)
-                    y1 = y_dim - 1;     // Clip end point to screen.
-                if (y0 < 0)
-                    y0 = 0;             // Clip start point to screen.
-                draw_vline (x0, y0, y1, s_r);
+                int dx;                 // Distance from the centre
+                int nx;                 // Distance of the outer neighbour
+                int top;                // The top of the column
+                int bot;                // The bottom of the column
+                uint8_t mask;
+
+                dx = circle_dx (xx + ii, x0, xgap);
+                top = y0 - circle_height [dx];
+                bot = y0 + ygap + circle_height [dx];
+                nx = circle_dx (xx + ii - 1, x0, xgap);
+                if (nx <= dx)
+                    nx = circle_dx (xx + ii + 1, x0, xgap);
+
+                // The fill and the outside columns are the whole column,
+                // otherwise the outline is the top and bottom rows that are
+                // not covered by the outer neighbour.
+                if ((s_r & MODE_FILL) || (nx > r))
+                    mask = page_mask (top, bot, py);
+                else
+                {
+                    int len;
+
+                    len = circle_height [dx] - circle_height [nx];
+                    if (len <= 0)
+                        len = 1;
+                    mask = (page_mask (top, top + len - 1, py) |
+                            page_mask (bot - len + 1, bot, py));
+                }
+                draw_buffer [ii] = mask & rows;
             }
+            mask_flush (xx, py, width, s_r & ~MODE_FILL);
         }
     }
 }
@@ -354,7 +956,7 @@ clip_vline (int x0, int y0, int y1, uint8_t s_r)
 // circle quality is dubious at a small radius so we keep the existing one
 // used by Jennifer Holt.
 static void
-_draw_circle (uint8_t xin, uint8_t yin, uint8_t xgap, uint8_t ygap, uint8_t rin, uint8_t s_r)
+_draw_circle (int xin, int yin, uint8_t xgap, uint8_t ygap, uint8_t rin, uint8_t s_r)
 {
     int r = rin;
     int f = 1 - r;
@@ -368,6 +970,14 @@ _draw_circle (uint8_t xin, uint8_t yin, uint8_t xgap, uint8_t ygap, uint8_t rin,
 
     // Sort out the drawing mode
     s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~MODE_NORMAL_MASK);
+
+    // The KS0108B composes each page row of the circle in a single pass.
+    if (!is_large () && (rin < LINE_SPAN_MAX))
+    {
+        span_circle (xin, yin, xgap, ygap, rin, s_r);
+        return;
+    }
+
     xstart = x;
     while(x < y)
     {
@@ -487,8 +1097,8 @@ _draw_circle (uint8_t xin, uint8_t yin, uint8_t xgap, uint8_t ygap, uint8_t rin,
 void
 draw_circle (uint8_t xin, uint8_t yin, uint8_t rin, uint8_t s_r)
 {
-    // Invoke the _draw_circle function
-    _draw_circle (xin, yin, 0, 0, rin, s_r);
+    // Invoke the _draw_circle function at the origin.
+    _draw_circle (xin + origin_x, yin + origin_y, 0, 0, rin, s_r);
 }
 
 /**
@@ -529,395 +1139,309 @@ draw_rbox (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t radius, uint8
         radius2 = diff;
     }
 
-    // Invoke the _draw_circle function
-    _draw_circle (x1 + radius, y1 + radius,
+    // Invoke the _draw_circle function at the origin.
+    _draw_circle (x1 + radius + origin_x, y1 + radius + origin_y,
                   xdiff - radius2, ydiff - radius2,
                   radius, s_r);
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Get the columns of an edge of a polygon on a row. The columns are those
+/// of the pixels that draw_line() plots for the edge so the fill covers the
+/// outline of the polygon exactly. A shallow edge has a run of pixels on a
+/// row and a steep edge a single pixel.
 ///
-/// Fill a convex polygons defined in a clockwise direction. The algorithm
-/// will cope with concave shapes in the y-direction but does not cope with
-/// all concave shapes in the x direction.
-///
-/// The algorithm uses besenham's line drawing algorithm and creates vertical
-/// scal lines between the top and bottom of the polygone. Provided that the
-/// vertical scan line is contained within the vertical scan line then the
-/// shape will fill correctly. What this means is:
-///
-/// @    +--+  +--+
-/// @    |  |  |  |
-/// @ +--+  +--+  +--+
-/// @ |              |    OK all vertical scan lines connected.
-/// @ +--+  +--+  +--+
-/// @    |  |  |  |
-/// @    +--+  +--+
-/// @
-/// @ +----------+
-/// @ |  +-------+
-/// @ |  |
-/// @ |  +-----+         OK because of clockwise scan.
-/// @ |  +-----+
-/// @ |  |
-/// @ |  +-------+
-/// @ +----------+
-/// @
-/// @ $---------+
-/// @ +-------@ |        FAILS starting at '$' because cannot resolve convex.
-/// @         | |        OK starting at '@' because can resolve convex
-/// @ +-------+ |
-/// @ +---------+
-///
-/// The algorithm works by determining the direction of the line and operates
-/// in clockwise direction. A line is drawn between each successive point and
-/// the y-value is saved in the buffer[x] if it is already empty (0xff). If
-/// the buffer[x] has a value then a vertical line is rendered between the
-/// x,y position of the current line and the x,buffer[x] stored position.
-///
-/// The libne drawing renders the whole line EXCEPT the last point of the
-/// line to ensiure that points are not duplicated. Special handling is
-/// required at the points where the line changes direction from forward
-/// moving to backward moving. At forward/backward transition (because only 1
-/// point is processed) then an extra plot is introduced this means that if
-/// the buffer[x] is empty the y-position is saved or when set to a valid
-/// y-value then a line is drawn.
-///
-/// A line moves in the forward direction if (x>x1) or ((x==x1) & (y<y1)). A
-/// line moves in a backward direction if (x<x1) or ((x==x1) & (y>y1)).
-///
-/// At the end of the polygon fill we check to ensure that there is not a
-/// residual draw in the buffer which has not been consumed, if there is then
-/// we need a pixel at this location.
+/// @param [in] xy The vertex at the start of the edge.
+/// @param [in] xy1 The vertex at the end of the edge.
+/// @param [in] y The row, within the edge.
+/// @param [out] span The first and last column of the edge on the row.
 ///
-/// @param [in] s_r The fill colour
-/// @param [in] x The first and last x-coordinate
-/// @param [in] y The first and last y-coordinate
+/// @return Non-zero if the edge crosses the row for the even-odd rule.
 ///
-static void
-_fill_polygon (uint8_t s_r, uint8_t x, uint8_t y)
+static uint8_t
+polygon_edge (uint8_t *xy, uint8_t *xy1, uint8_t y, uint8_t *span)
 {
-    // Cached y coordinates.
-    uint8_t write_ystart;               // The writing start y-coordinate
-    uint8_t write_yend;                 // The writing end y-coordinate
+    uint16_t deltax;                    // Difference in x
+    uint16_t deltay;                    // Difference in y
+    uint16_t row;                       // The row within the edge
+    uint8_t lo, hi;                     // The pixels of the row
 
-    // Working variables.
-    uint8_t last_coord = 0;             // The last coordinate.
-    uint8_t xfirst, yfirst;             // Working x,y coordinates
-    int8_t direction = -1;              // Current Direction
-    int8_t direction_changed = 0;       // Direction has changed.
-
-    // Initialise our line buffer
-    write_ystart = y;
-    write_yend = y;
-    if (y_valid(y))
-        draw_buffer[y] = 0xff;
-    xfirst = x;
-    yfirst = y;
+    deltax = (xy1[0] >= xy[0]) ? xy1[0] - xy[0] : xy[0] - xy1[0];
+    deltay = (xy1[1] >= xy[1]) ? xy1[1] - xy[1] : xy[1] - xy1[1];
+    row = (y >= xy[1]) ? y - xy[1] : xy[1] - y;
 
-    do
+    if (deltax < deltay)
     {
-        uint8_t x1, y1;                 // Working x,y coordinates
-        int16_t deltax;                 // Difference in x;
-        int16_t deltay;                 // Difference in y;
-        int8_t xinc;                    // X-coordinate increment.
-        int8_t yinc;                    // X-coordinate increment.
-
-        // Get the end marker out of the last coordinate and normalise
-        if (last_coord == 0)
-        {
-            // Read data from serial.
-            x1 = serial_getc();
-            y1 = serial_getc();
+        // Steep, the x-coordinate of the pixel on the row.
+        lo = ((deltay >> 1) + (row * deltax)) / deltay;
+        hi = lo;
+    }
+    else if (deltay == 0)
+    {
+        // Horizontal, the whole edge.
+        lo = 0;
+        hi = deltax;
+    }
+    else
+    {
+        uint16_t half = deltax >> 1;
+
+        // Shallow, the pixels where the Bresenham row is this row.
+        lo = 0;
+        if ((row * deltax) > half)
+            lo = ((row * deltax) - half + deltay - 1) / deltay;
+        hi = deltax;
+        if (row < deltay)
+            hi = ((((row + 1) * deltax) - half + deltay - 1) / deltay) - 1;
+    }
 
-            // Handle the end of the polygon and strip out the signalling.
-            last_coord = y1 & 0x80;
-            y1 &= ~0x80;
-        }
-        else
-        {
-            // We have processed the last coordinate. Draw a line from the
-            // last coordinate to the first coordinate.
-            x1 = xfirst;
-            y1 = yfirst;
-            yfirst |= 0x80;             // mark as end the loop
-        }
+    // Convert the pixels to columns.
+    if (xy1[0] >= xy[0])
+    {
+        span[0] = xy[0] + lo;
+        span[1] = xy[0] + hi;
+    }
+    else
+    {
+        span[0] = xy[0] - hi;
+        span[1] = xy[0] - lo;
+    }
 
-        // Horizontal lines cause a problem for concave shapes when filling
-        // with XOR as we have to be very careful that we do not over-draw
-        // any line as this causes an anomaly in the fill. Process the line
-        // segment immediately and effectivelly reduce the line to a point.
-        // We skip the direction processing and will effectively carry the
-        // direction change to any next line segment.
-        //
-        // Ignore all horizontal lines as the x coordinates will be repeated
-        // on another coordinate. Sort out the y values.
-        if (y == y1)
-        {
-            uint8_t xstart;
-            uint8_t xend;
-            uint8_t buffer = draw_buffer[y];
+    // The edge crosses every row but its lowest so that a vertex shared by
+    // two edges is only counted once.
+    return (deltay != 0) && (y != ((xy[1] > xy1[1]) ? xy[1] : xy1[1]));
+}
 
-            // Throw out a coincidental point.
-            if (x == x1)
-                continue;               // This is the same point, discard.
+/////////////////////////////////////////////////////////////////////////////
+/// Add a run of columns of a polygon row to the masks at the start of the
+/// draw_buffer. The KS0108B masks are the columns of a page and the T6963
+/// masks are the bytes of the row. The run is moved by the origin onto the
+/// masks.
+///
+/// @param [in] x The first column.
+/// @param [in] x1 The last column.
+/// @param [in] y The row.
+/// @param [in] cx The first screen column of the masks.
+/// @param [in] cend The last screen column of the masks.
+///
+static void
+polygon_span (uint8_t x, uint8_t x1, uint8_t y, uint8_t cx, uint8_t cend)
+{
+    int sx = x + origin_x;              // The run on the screen
+    int sx1 = x1 + origin_x;
 
-            // Determine the direction of the line from x
-            if (x > x1)
-            {
-                // Going left, this is backwards i.e. (x1,y) <--- (x,y)
+    // Clip the run to the masks.
+    if (sx < cx)
+        sx = cx;
+    if (sx1 > cend)
+        sx1 = cend;
 
-                // If the direction is reverse then do not do anything as the
-                // next line segment will process the start of line.
-                if (direction <= 0)
-                    goto skip_line;
+    y += origin_y;
+    for (; sx <= sx1; sx++)
+    {
+        if (is_large ())
+            draw_buffer [sx >> 3] |= 0x80 >> (sx & 0x7);
+        else
+            draw_buffer [sx - cx] |= 1 << (y & 0x7);
+    }
+}
 
-                // Otherwise draw the line. If the draw_buffer is defined
-                // then advance the draw buffer position to the end point.
-                if ((buffer != 0xff) && (buffer >= x))
-                {
-                    xstart = buffer;
-                    draw_buffer[y] = 0xff /* x1*/;
-                }
-                else
-                    xstart = x;
-                xend = x1 + 1;
-            }
-            else
-            {
-                // Going right, this is forwards. i.e. (x,y) ---> (x1,y)
+/////////////////////////////////////////////////////////////////////////////
+/// Add a row of a polygon to the masks. The pixels of every edge on the row
+/// are added and the columns between the edges are filled using the
+/// even-odd rule so that concave polygons are filled correctly.
+///
+/// @param [in] count The number of vertices.
+/// @param [in] y The row.
+/// @param [in] cx The first screen column of the masks.
+/// @param [in] cend The last screen column of the masks.
+///
+static void
+polygon_row (uint8_t count, uint8_t y, uint8_t cx, uint8_t cend)
+{
+    uint8_t crossings = 0;              // The number of edge crossings
+    uint8_t ii;
 
-                // If the direction is currently forward then do not do
-                // anything as the next line segment will process the line.
-                if (direction != 0)
-                    goto skip_line;
+    for (ii = 0; ii < count; ii++)
+    {
+        uint8_t *xy;                    // The start of the edge
+        uint8_t *xy1;                   // The end of the edge
+        uint8_t span [2];               // The columns of the edge
 
-                // Otherwise draw the line. If the draw_buffer is defined
-                // then advance the draw buffer position to the end point.
-                if ((buffer != 0xff) && (buffer <= x))
-                {
-                    xstart = buffer;
-                    draw_buffer[y] = 0xff /* x1*/;
-                }
-                else
-                    xstart = x;
-                xend = x1 - 1;
-            }
-            draw_hline (xstart, y, xend, s_r);
+        // The last edge closes the polygon.
+        xy = &polygon_vertex [ii << 1];
+        xy1 = (ii == count - 1) ? polygon_vertex : xy + 2;
 
-            // Advance the point.
-skip_line:  x = x1;                     // Move the x to the next point.
-            continue;                   // Skip any drawing, not processed.
-        }
-        else if (y1 > y)                // The y-values are increasing
+        // Ignore the edge if it is not on the row.
+        if (((y < xy[1]) && (y < xy1[1])) || ((y > xy[1]) && (y > xy1[1])))
+            continue;
+
+        // Draw the edge and insert any crossing into the sorted crossings.
+        if (polygon_edge (xy, xy1, y, span))
         {
-            yinc = 1;
-            deltay = y1 - y;            // The difference between the y's
-            // If y is increasing downwards then grow the buffer.
-            while ((y1 > write_yend) && (write_yend < y_dim - 1))
-                draw_buffer [++write_yend] = 0xff;
-
-            // Going down, this is forwards
-            if (direction >= 0)
-                direction_changed = direction ^ 1;
-            direction = 1;
+            uint8_t jj;
+
+            for (jj = crossings++; (jj > 0) && (polygon_cross [jj - 1] > span[0]); jj--)
+                polygon_cross [jj] = polygon_cross [jj - 1];
+            polygon_cross [jj] = span[0];
         }
-        else                            // The y-values are decreasing
+        polygon_span (span[0], span[1], y, cx, cend);
+    }
+
+    // Fill between each pair of crossings.
+    for (ii = 1; ii < crossings; ii += 2)
+        polygon_span (polygon_cross [ii - 1], polygon_cross [ii], y, cx, cend);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Fill a polygon. The vertices are collected and the polygon is filled
+/// with a scanline edge table using the even-odd rule so any simple polygon,
+/// convex or concave, is filled. The rows are composed as masks and merged
+/// with the screen a page of 64 columns at a time on the KS0108B and a row
+/// at a time on the T6963 so each byte of the screen is only written once.
+///
+/// The vertices are held in the draw_buffer, a polygon with more than
+/// POLYGON_MAX vertices is not filled.
+///
+/// @param [in] s_r The fill colour
+/// @param [in] x The first and last x-coordinate
+/// @param [in] y The first and last y-coordinate
+/// @param [in] data The list of x,y coordinates. The last y coordinate is
+///                  marked with the top bit set to 0x80. NULL reads the
+///                  coordinates from the serial input.
+///
+static void
+_fill_polygon (uint8_t s_r, uint8_t x, uint8_t y, uint8_t *data)
+{
+    uint8_t count;                      // The number of vertices
+    uint8_t xmin, xmax;                 // The columns of the polygon
+    uint8_t ymin, ymax;                 // The rows of the polygon
+    int left, right;                    // The columns on the screen
+    int top, bottom;                    // The rows on the screen
+    uint8_t last = 0;                   // The last vertex has been read
+    uint8_t ii;
+
+    // Collect the vertices.
+    count = 0;
+    for (;;)
+    {
+        if (count < POLYGON_MAX)
         {
-            yinc = -1;
-            deltay = y - y1;
-            // If the y is decreasing upwards then grow the buffer
-            while ((y1 < write_ystart) && (write_ystart > 0))
-                draw_buffer [--write_ystart] = 0xff;
-
-            // Going up, this is backwards
-            if (direction >= 0)
-                direction_changed = direction ^ 0;
-            direction = 0;
+            polygon_vertex [count << 1] = x;
+            polygon_vertex [(count << 1) + 1] = y;
         }
+        if (count <= POLYGON_MAX)
+            count++;
+        if (last != 0)
+            break;
 
-        // Sort out the x values
-        if (x1 >= x)                       // The x-values are increasing
+        if (data != NULL)
         {
-            if (x1 == x)
-                xinc = 0;
-            else
-                xinc = 1;
-            deltax = x1 - x;
+            x = *data++;
+            y = *data++;
         }
-        else                                // The y-values are decreasing
+        else
         {
-            xinc = -1;
-            deltax = x - x1;
+            x = serial_getc ();
+            y = serial_getc ();
         }
 
-        /* If the direction has changed then process the last pixel we did
-         * not plot. We need some special handling because we only visit this
-         * pixel once. If draw_the buffer[y] is not initialised then write
-         * our current y value, this is the end of the last line. if the
-         * buffer[y] is valid then we need to draw a line to the x position
-         * in the buffer. */
-        if (direction_changed)
-        {
-            uint8_t buffer = draw_buffer[y];
-
-            // Handle the special case of internal and corners with care, we
-            // do not want to promote drawing for an internal corner.
-            // On internal corners then do not process.
-
-            // Going forwards
-            if (direction == 1)
-            {
-                if (buffer == 0xff)
-                    draw_buffer[y] = x;
-                else if (buffer > x)
-                {
-                    draw_hline (x+1, y, buffer, s_r);
-                    draw_buffer[y] = 0xff;
-                }
-            }
-            // Going backwards
-            else
-            {
-                if (buffer == 0xff)
-                    draw_buffer[y] = x;
-                else if (buffer < x)
-                {
-                    draw_hline (x-1, y, buffer, s_r);
-                    draw_buffer[y] = 0xff;
-                }
-            }
-        }
+        // Handle the end of the polygon and strip out the signalling.
+        last = y & 0x80;
+        y &= ~0x80;
+    }
 
-        // There is at least one x-value for every y-value. Handle the incrementing
-        // and decremening separately.
-        if (deltax >= deltay)
-        {
-            int16_t denominator;             // Denominator
-            int16_t numerator;               // Numerator
-            int16_t numadd;                  // Numerator to add.
-            int16_t numpixels;               // Number of pixels to write.
-            uint8_t xstart;             // X start point
-
-            // Calculate the Bresenham parameters
-            denominator = deltax;           // The denominator
-            numerator = deltax / 2;         // The numerator
-            numadd = deltay;                // Increment of the numerator
-            numpixels = deltax;             // There are more x-values than y-values -1
-            xstart = x;                 // Save the start point
-
-            // Write all of the pixels EXCLUDING the last pixel of the line.
-            while (--numpixels >= 0)
-            {
-                numerator += numadd;          // Increase the numerator by the top of the fraction
-                if (numerator >= denominator) // Check if numerator >= denominator
-                {
-                    uint8_t buffer;
-
-                    // If we are going backwards with a positive increment or
-                    // going forwards with a negative increment then save the
-                    // start x position for plotting.
-                    if (((direction == 1) && (xinc > 0)) ||
-                        ((direction == 0) && (xinc < 0)))
-                        xstart = x;
-
-                    // This is the only position where y changes. Flush out
-                    // the last y change before we increment it.
-                    buffer = draw_buffer[y];
-                    if (buffer != 0xff)
-                    {
-                        // Draw the horizontal line to fill the column and
-                        // clear the y buffer
-                        draw_hline (xstart, y, buffer, s_r);
-                        xstart = 0xff;
-                    }
-                    draw_buffer[y] = xstart;
+    // The polygon does not fit, the vertices have been consumed so give up.
+    if (count > POLYGON_MAX)
+        return;
 
-                    numerator -= denominator; // Calculate the new numerator value
-                    y += yinc;                // Change the y as appropriate
-                    x += xinc;                // Change the x for the nxt loop
-                    xstart = x;               // Save the start position.
-                }
-                else
-                {
-                    // Advance the x-coordinate
-                    x += xinc;
-                }
-            }
+    // Find the extent of the polygon.
+    xmin = xmax = polygon_vertex [0];
+    ymin = ymax = polygon_vertex [1];
+    for (ii = 1; ii < count; ii++)
+    {
+        x = polygon_vertex [ii << 1];
+        y = polygon_vertex [(ii << 1) + 1];
+        if (x < xmin)
+            xmin = x;
+        if (x > xmax)
+            xmax = x;
+        if (y < ymin)
+            ymin = y;
+        if (y > ymax)
+            ymax = y;
+    }
 
-            // Catch any residue horizontal transition that has not been
-            // recorded. This occurs for convex shapes where x is advanced
-            // without y.
-            if (xstart != x)
-            {
-                uint8_t buffer = draw_buffer[y];
+    // Move the extent by the origin and clip it, the extent is then the
+    // screen columns and rows that are composed.
+    left = xmin + origin_x;
+    if (left < clip_x0)
+        left = clip_x0;
+    right = xmax + origin_x;
+    if (right > clip_x1)
+        right = clip_x1;
+    top = ymin + origin_y;
+    if (top < clip_y0)
+        top = clip_y0;
+    bottom = ymax + origin_y;
+    if (bottom > clip_y1)
+        bottom = clip_y1;
+    if ((left > right) || (top > bottom))
+        return;
+    xmin = left;
+    xmax = right;
+    ymin = top;
+    ymax = bottom;
+    s_r &= ~MODE_FILL;
 
-                // This is the only position where y changes. Flush out
-                // the last y change before we increment it.
-                if (buffer != 0xff)
-                {
-                    // Draw the vertical line to fill the column and
-                    // clear the y buffer
-                    draw_hline (xstart, y, buffer, s_r);
-                    xstart = 0xff;
-                }
-                draw_buffer[y] = xstart;
-            }
+    if (is_large ())
+    {
+        // Compose each row as bytes and merge the bytes that have pixels.
+        for (y = ymin; y <= ymax; y++)
+        {
+            uint8_t first;              // The first byte of the row
+            uint8_t end;                // The last byte of the row
+
+            first = xmin >> 3;
+            end = xmax >> 3;
+            memset (draw_buffer, 0, end + 1);
+            polygon_row (count, y - origin_y, xmin, xmax);
+
+            while ((first < end) && (draw_buffer [first] == 0))
+                first++;
+            while ((end > first) && (draw_buffer [end] == 0))
+                end--;
+            if (draw_buffer [first] != 0)
+                mask_hbitblt (first << 3, y, (end - first + 1) << 3, s_r,
+                              &draw_buffer [first]);
         }
-        // There is at least one y-value for every x-value
-        else
+    }
+    else
+    {
+        uint8_t py;                     // The top row of the page
+
+        // Compose each page 64 columns at a time, the columns of a chip.
+        for (py = ymin & ~0x7; py <= ymax; py += 8)
         {
-            int16_t denominator;             // Denominator
-            int16_t numerator;               // Numerator
-            int16_t numadd;                  // Numerator to add.
-            int16_t numpixels;               // Number of pixels to write.
-
-            // Calculate the Bresenham parameters
-            denominator = deltay;
-            numerator = deltay / 2;
-            numadd = deltax;
-            numpixels = deltay;             // There are more y-values than x-values
-
-            // Write all of the pixels EXCLUDING the last pixel.
-            while (--numpixels >= 0)
+            uint8_t cx;                 // The first column of the masks
+
+            for (cx = xmin; cx <= xmax; cx = (cx | 0x3f) + 1)
             {
-                uint8_t buffer = draw_buffer[y];
+                uint8_t cend;           // The last column of the masks
 
-                // We are about to increment y and move to the next column.
-                // Either save the point or draw the point.
-                if (buffer != 0xff)
-                {
-                    draw_hline (x, y, buffer, s_r);
-                    buffer = 0xff;
-                }
-                else
-                {
-                    buffer = x;
-                }
-                draw_buffer[y] = buffer;
+                cend = cx | 0x3f;
+                if (cend > xmax)
+                    cend = xmax;
+                memset (draw_buffer, 0, cend - cx + 1);
 
-                // Increment x if necessary.
-                numerator += numadd;          // Increase the numerator by the top of the fraction
-                if (numerator >= denominator) // Check if numerator >= denominator
+                for (y = py; (y < py + 8) && (y <= ymax); y++)
                 {
-                    numerator -= denominator; // Calculate the new numerator value
-                    x += xinc;                // Change the x as appropriate
+                    if (y >= ymin)
+                        polygon_row (count, y - origin_y, cx, cend);
                 }
-
-                // Increment y.
-                y += yinc;
+                mask_flush (cx, py, cend - cx + 1, s_r);
             }
         }
-
-        x = x1;
-        y = y1;
-    }
-    while ((yfirst & 0x80) == 0);
-    yfirst &= ~0x80;
-
-    // Flush out any first pixel
-    if (draw_buffer[yfirst] != 0xff)
-    {
-        draw_hline (xfirst, yfirst, draw_buffer[yfirst], s_r);
     }
 }
 
@@ -944,7 +1468,7 @@ draw_polygon (uint8_t s_r, uint8_t x, uint8_t y, uint8_t *data)
         // Correct the reverse flag
         s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~MODE_NORMAL_MASK);
         // Invoke the fill
-        _fill_polygon (s_r, x, y);
+        _fill_polygon (s_r, x, y, data);
     }
     else
     {
@@ -993,21 +1517,15 @@ draw_polygon (uint8_t s_r, uint8_t x, uint8_t y, uint8_t *data)
 void
 fill_vbox (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t data)
 {
-    uint8_t width;
-    uint8_t height;
-
-    // Get the top left corner of the block in x1, y1, Get the width and
-    // height of the block in the bitblt array.
+    // Get the top left corner of the block in x1, y1.
     if (x1 > x2)
         swap_bytes (x1, x2);
-    width = 1 + x2 - x1;         // Blit Width
-
     if (y1 > y2)
         swap_bytes (y1, y2);
-    height = 1 + y2 - y1;         // Blit Height
 
-    // Use erase mode of bitblt to draw the block.
-    lcd_vbitblt (x1, y1, width, height, MODE_FILL|prefs_reverse, &data);
+    // Use erase mode of bitblt to draw the block at the origin.
+    clip_box (x1 + origin_x, y1 + origin_y, x2 + origin_x, y2 + origin_y,
+              prefs_reverse, data);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -1016,25 +1534,18 @@ fill_vbox (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t data)
 void
 fill_box (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t s_r)
 {
-    uint8_t width;
-    uint8_t height;
-    uint8_t data = 0xff;
-
     // Correct the reverse flag
     s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~MODE_NORMAL_MASK);
 
-    // Get the top left corner of the block in x1, y1, Get the width and
-    // height of the block in the bitblt array.
+    // Get the top left corner of the block in x1, y1.
     if (x1 > x2)
         swap_bytes (x1, x2);
-    width = 1 + x2 - x1;                // Blit Width
-
     if (y1 > y2)
         swap_bytes (y1, y2);
-    height = 1 + y2 - y1;               // Blit Height
 
-    // Use erase mode of bitblt to draw the block.
-    lcd_vbitblt (x1, y1, width, height, s_r | MODE_FILL, &data);
+    // Use erase mode of bitblt to draw the block at the origin.
+    clip_box (x1 + origin_x, y1 + origin_y, x2 + origin_x, y2 + origin_y,
+              s_r, 0xff);
 }
 
 /**
@@ -1056,6 +1567,8 @@ draw_box (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t s_r)
     }
     else
     {
+        int sx1, sy1, sx2, sy2;         // The corners on the screen
+
         // Correct the reverse flag and clear any line modes that have been set.
         s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~(MODE_LINE_MASK|MODE_NORMAL_MASK));
 
@@ -1069,11 +1582,16 @@ draw_box (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t s_r)
         if (y1 > y2)
             swap_bytes (y1, y2);
 
+        sx1 = x1 + origin_x;
+        sy1 = y1 + origin_y;
+        sx2 = x2 + origin_x;
+        sy2 = y2 + origin_y;
+
         // Draw a box in a clockwise direction and chain the lines.
-        draw_hline (x1, y1, x2-1, s_r);     // Top horizontal.
-        draw_vline (x2, y1, y2-1, s_r);     // Right vertical.
-        draw_hline (x2, y2, x1+1, s_r);     // Bottom horizontal.
-        draw_vline (x1, y2, y1+1, s_r);     // Left vertical.
+        clip_hline (sx1, sy1, sx2-1, s_r);  // Top horizontal.
+        clip_vline (sx2, sy1, sy2-1, s_r);  // Right vertical.
+        clip_hline (sx2, sy2, sx1+1, s_r);  // Bottom horizontal.
+        clip_vline (sx1, sy2, sy1+1, s_r);  // Left vertical.
     }
 }
 
@@ -1086,6 +1604,160 @@ erase_box (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
     fill_box (x1, y1, x2, y2, ~prefs_reverse & MODE_NORMAL_MASK);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// Vertical bitblt of a bitmap at an integer scale clipped to the clip
+/// rectangle. Each bit of the data is expanded to a scale x scale square.
+/// The source is taken a band of 8 rows at a time and each band is drawn as
+/// tiles of up to 8 rows and SCALE_TILE columns with the driver bitblt, so a
+/// scaled bitmap costs the same bytes on the serial as an unscaled one. The
+/// tiles outside of the clip are discarded and the tiles on the edge are cut
+/// to the clip, an unscaled bitmap within the clip is drawn by the driver.
+///
+/// @param [in] x,y is upper left corner of image on the screen.
+/// @param [in] width,height The size of the data in pixels.
+/// @param [in] mode The resolved driver mode, see lcd_vbitblt().
+/// @param [in] scale The scale 1..4.
+/// @param [in] data The data or NULL for serial.
+///
+static void
+clip_vbitblt (int x, int y, uint8_t width, uint8_t height,
+              uint8_t mode, uint8_t scale, uint8_t *data)
+{
+    int right;                          // Right column of the bitmap
+    int bottom;                         // Bottom row of the bitmap
+    uint8_t row;                        // Top row of the source band
+    uint8_t tile;                       // Source columns of a tile
+
+#ifndef DRAW_SCALE
+    // Only the unscaled bitmap is built, the tiles are then only used to
+    // clip.
+    scale = 1;
+#endif
+    right = x + (width * scale) - 1;
+    bottom = y + (height * scale) - 1;
+
+    // A fill is a box.
+    if (mode & MODE_FILL)
+    {
+        clip_box (x, y, right, bottom, mode & ~MODE_FILL, *data);
+        return;
+    }
+
+    if ((scale == 1) && clip_inside (x, y, right, bottom))
+    {
+        lcd_vbitblt (x, y, width, height, mode, data);
+        return;
+    }
+
+    tile = SCALE_TILE / scale;
+    for (row = 0; row < height; row += 8)
+    {
+        uint8_t *src;                   // The source band
+        uint8_t rows;                   // Rows of the scaled band
+        uint8_t top;                    // Row of the tile in the band
+        uint8_t col;                    // Source column
+
+        // Collect a scaled band from the serial, an unscaled band is read
+        // from the serial as the tiles are expanded. A bitmap in memory is
+        // used in place.
+        if (data == NULL)
+        {
+            src = NULL;
+            if (scale > 1)
+            {
+                for (col = 0; col < width; col++)
+                    scale_source [col] = serial_getc ();
+                src = scale_source;
+            }
+        }
+        else
+        {
+            src = data;
+            data += width;
+        }
+
+        rows = height - row;
+        if (rows > 8)
+            rows = 8;
+        rows *= scale;
+
+        for (top = 0; top < rows; top += 8)
+        {
+            int ty = y + (row * scale) + top;
+            int t0, t1;                 // Rows of the tile in the clip
+            uint8_t first_mask;         // Source bit of the first tile row
+            uint8_t first_count;        // Rows of the first source bit
+
+            t0 = (ty > clip_y0) ? ty : clip_y0;
+            t1 = ty + (((rows - top) > 8) ? 8 : (rows - top)) - 1;
+            if (t1 > clip_y1)
+                t1 = clip_y1;
+
+            first_mask = 1 << (top / scale);
+            first_count = top % scale;
+            for (col = 0; col < width; col += tile)
+            {
+                int tx = x + (col * scale);
+                int c0, c1;             // Columns of the tile in the clip
+                uint8_t *dst = scale_tile;
+                uint8_t end;            // End source column of the tile
+                uint8_t ii;
+
+                end = col + tile;
+                if (end > width)
+                    end = width;
+
+                c0 = (tx > clip_x0) ? tx : clip_x0;
+                c1 = tx + ((end - col) * scale) - 1;
+                if (c1 > clip_x1)
+                    c1 = clip_x1;
+
+                // Discard the tiles outside of the clip unless the tile is
+                // read from the serial.
+                if (((t0 > t1) || (c0 > c1)) && (src != NULL))
+                    continue;
+
+                // Expand the rows of each source column and repeat the
+                // column across the tile.
+                for (ii = col; ii < end; ii++)
+                {
+                    uint8_t bits;
+                    uint8_t mask = first_mask;
+                    uint8_t count = first_count;
+                    uint8_t out = 0;
+                    uint8_t bit;
+
+                    bits = (src != NULL) ? src [ii] : serial_getc ();
+                    for (bit = 1; bit != 0; bit <<= 1)
+                    {
+                        if (bits & mask)
+                            out |= bit;
+                        if (++count == scale)
+                        {
+                            count = 0;
+                            mask <<= 1;
+                        }
+                    }
+                    for (count = 0; count < scale; count++)
+                        *dst++ = out;
+                }
+                if ((t0 > t1) || (c0 > c1))
+                    continue;
+
+                // Cut the tile to the clip, the rows above the clip are
+                // shifted out of the columns.
+                dst = &scale_tile [c0 - tx];
+                if (t0 > ty)
+                {
+                    for (ii = 0; ii <= c1 - c0; ii++)
+                        dst [ii] >>= t0 - ty;
+                }
+                lcd_vbitblt (c0, t0, c1 - c0 + 1, t1 - t0 + 1, mode, dst);
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// Vertical bitblt does a bit transfer from data to display memory. If NULL
 /// is passed as data, bitblt assumes the data is to come from the serial
@@ -1129,8 +1801,85 @@ draw_vbitblt (uint8_t x, uint8_t y, uint8_t s_r, uint8_t *data)
 {
     uint8_t width;                      // Width of the bitmap
     uint8_t height;                     // Height of the bitmap
+    uint8_t scale;                      // Scale of the bitmap
 
-    s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~(MODE_LINE_MASK|MODE_NORMAL_MASK));
+    scale = drawing_scale;
+    s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~MODE_NORMAL_MASK);
+
+    // Get the width and the height from the data stream.
+    if (data == NULL)
+    {
+        width = serial_getc();
+        height = serial_getc();
+    }
+    else
+    {
+        width = *data++;
+        height = *data++;
+    }
+
+    // Make sure we have legal dimensions otherwise discard the data.
+    if ((height < 1) || (height > y_dim / scale) ||
+        (width < 1) || (width > x_dim / scale))
+    {
+        // If we are reading from serial then consume all of the content from
+        // the serial input.
+        if (data == NULL)
+        {
+            uint8_t row, col;
+
+            // Iterate over all of the data that's coming in.
+            for (row = 0; row < height; row++)
+                for (col = 0; col < width; col++)
+                    serial_getc ();
+        }
+
+        // Quit the command there is an error.
+        return;
+    }
+
+    // Draw the bitmap at the origin.
+    clip_vbitblt (x + origin_x, y + origin_y, width, height, s_r, scale, data);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Vertical bitblt of a bitmap at an integer scale. The bitmap is clipped to
+/// the clip rectangle but is not moved by the origin.
+///
+/// @param [in] x,y is upper left corner of image on the screen.
+/// @param [in] width,height The size of the data in pixels.
+/// @param [in] mode The resolved driver mode, see lcd_vbitblt().
+/// @param [in] scale The scale 1..4.
+/// @param [in] data The data or NULL for serial.
+///
+void
+draw_scaled_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                     uint8_t mode, uint8_t scale, uint8_t *data)
+{
+    clip_vbitblt (x, y, width, height, mode, scale, data);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Horizontal bitblt does a bit transfer of row organised data to display
+/// memory. The data is (width + 7) / 8 bytes per row, most significant bit
+/// on the left, which matches the T6963 display memory. If NULL is passed as
+/// data, bitblt takes the data from the serial port and will not return
+/// until it gets all the bytes it wants.
+///
+/// @param [in] x,y is upper left corner of image in pixels.
+/// @param [in] s_r The mode, see draw_vbitblt(). MODE_FILL is ignored.
+/// @param [in] data The width, height and row data or NULL for serial.
+///
+void
+draw_hbitblt (uint8_t x, uint8_t y, uint8_t s_r, uint8_t *data)
+{
+    uint8_t width;                      // Width of the bitmap
+    uint8_t height;                     // Height of the bitmap
+    uint8_t row_bytes;                  // The bytes in a row of the bitmap
+    int sx, sy;                         // The bitmap on the screen
+    int c0, c1;                         // The columns in the clip
+
+    s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & ~(MODE_LINE_MASK|MODE_NORMAL_MASK|MODE_FILL));
 
     // Get the width and the height from the data stream.
     if (data == NULL)
@@ -1155,6 +1904,7 @@ draw_vbitblt (uint8_t x, uint8_t y, uint8_t s_r, uint8_t *data)
             uint8_t row, col;
 
             // Iterate over all of the data that's coming in.
+            width = (uint8_t)((width + 7) >> 3);
             for (row = 0; row < height; row++)
                 for (col = 0; col < width; col++)
                     serial_getc ();
@@ -1164,6 +1914,112 @@ draw_vbitblt (uint8_t x, uint8_t y, uint8_t s_r, uint8_t *data)
         return;
     }
 
-    // Invoke the screen driver to perform the bitblt operation.
-    ((vfunc_iiiiip_t)(pgm_read_word(&functabP [F_DRV_VBITBLT])))(x, y, width, height, s_r, data);
+    // Invoke the screen driver to perform the bitblt operation at the
+    // origin when the bitmap is within the clip.
+    sx = x + origin_x;
+    sy = y + origin_y;
+    if (clip_inside (sx, sy, sx + width - 1, sy + height - 1))
+    {
+        ((vfunc_iiiiip_t)(pgm_read_word(&functabP [F_DRV_HBITBLT])))(sx, sy, width, height, s_r, data);
+        return;
+    }
+
+    // Otherwise draw the rows in the clip one at a time. Each row is
+    // collected at the start of the draw_buffer, which the drivers read
+    // ahead of, and the columns left of the clip are shifted out.
+    row_bytes = (width + 7) >> 3;
+    c0 = (sx > clip_x0) ? sx : clip_x0;
+    c1 = sx + width - 1;
+    if (c1 > clip_x1)
+        c1 = clip_x1;
+    for (; height > 0; height--, sy++)
+    {
+        uint8_t ii;
+
+        for (ii = 0; ii < row_bytes; ii++)
+        {
+            if (data == NULL)
+                draw_buffer [ii] = serial_getc ();
+            else
+                draw_buffer [ii] = *data++;
+        }
+        draw_buffer [ii] = 0;
+
+        if ((sy < clip_y0) || (sy > clip_y1) || (c0 > c1))
+            continue;
+
+        if (c0 > sx)
+        {
+            uint8_t skip = (c0 - sx) >> 3;  // Bytes left of the clip
+            uint8_t shift = (c0 - sx) & 7;  // Bits left of the clip
+
+            for (ii = 0; (ii + skip) < row_bytes; ii++)
+                draw_buffer [ii] = ((draw_buffer [ii + skip] << shift) |
+                                    (draw_buffer [ii + skip + 1] >> (8 - shift)));
+        }
+        ((vfunc_iiiiip_t)(pgm_read_word(&functabP [F_DRV_HBITBLT])))(c0, sy, c1 - c0 + 1, 1, s_r, draw_buffer);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Copy a rectangle of the screen to another position. The source and the
+/// destination are moved by the origin, the source is cut to the screen and
+/// the destination to the clip rectangle with the other rectangle cut to
+/// match. The driver copies the pixels on the display so only the command
+/// is sent over the serial, the rectangles may overlap.
+///
+/// @param [in] sx The left x-coordinate of the source.
+/// @param [in] sy The top y-coordinate of the source.
+/// @param [in] width The width of the rectangle in pixels.
+/// @param [in] height The height of the rectangle in pixels.
+/// @param [in] dx The left x-coordinate of the destination.
+/// @param [in] dy The top y-coordinate of the destination.
+/// @param [in] s_r The mode, the reverse and the merge of the copy.
+///
+void
+draw_copy_rect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                uint8_t dx, uint8_t dy, uint8_t s_r)
+{
+    int x0, y0;                         // The source on the screen
+    int x1, y1;                         // The destination on the screen
+    int w, h;                           // The size of the copy
+
+    // Correct the reverse flag and only keep the merge operation.
+    s_r = ((~s_r ^ prefs_reverse) & MODE_NORMAL_MASK) | (s_r & MODE_OP_MASK);
+
+    x0 = sx + origin_x;
+    y0 = sy + origin_y;
+    x1 = dx + origin_x;
+    y1 = dy + origin_y;
+    w = width;
+    h = height;
+
+    // Cut the source to the screen.
+    if (x0 + w > x_dim)
+        w = x_dim - x0;
+    if (y0 + h > y_dim)
+        h = y_dim - y0;
+
+    // Cut the destination to the clip, moving the source with the left and
+    // top edges.
+    if (x1 < clip_x0)
+    {
+        x0 += clip_x0 - x1;
+        w -= clip_x0 - x1;
+        x1 = clip_x0;
+    }
+    if (y1 < clip_y0)
+    {
+        y0 += clip_y0 - y1;
+        h -= clip_y0 - y1;
+        y1 = clip_y0;
+    }
+    if (x1 + w > clip_x1 + 1)
+        w = clip_x1 + 1 - x1;
+    if (y1 + h > clip_y1 + 1)
+        h = clip_y1 + 1 - y1;
+    if ((w <= 0) || (h <= 0))
+        return;
+
+    lcd_copy_rect (x0, y0, w, h, x1, y1, s_r);
 }
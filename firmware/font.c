@@ -41,6 +41,8 @@
  *
  ****************************************************************************/
 
+#include <string.h>
+
 #include <avr/pgmspace.h>
 #include <avr/interrupt.h>
 #include <avr/boot.h>
@@ -50,12 +52,30 @@
 // This include file stores all the revelant font data. You can make new ones
 // with the bmp2header_font utility in the utilities folder
 /* #include "font.h"                    -- The original 8x5 font. The 4's and 7's not so good. */
-#include "font_alt_5x8.h"               /* A updated 5x8 font which is slightly cleaner */
-#include "font_tom_thumb_3x6.h"         /* A small 3x6 font */
-// Noted that there is insufficient space to include the 16x10 font
+#include "fonts.h"                      /* The built in fonts */
+#include "fonttable.h"                  /* Generated width tables and packed fonts */
+
+// The fonts in font number order.
+#define FONT(name) name,
+#define FONT_PACKED(name) name##_packed,
+static const char * const font_table [] PROGMEM = { FONT_LIST };
+#undef FONT
+#undef FONT_PACKED
+
+// The glyph width tables of the fonts, packed fonts are not proportional.
+#define FONT(name) name##_width,
+#define FONT_PACKED(name) NULL,
+static const uint8_t * const font_width_table [] PROGMEM = { FONT_LIST };
+#undef FONT
+#undef FONT_PACKED
+
+// The number of fonts.
+#define FONT_NUM (sizeof (font_table) / sizeof (font_table [0]))
 
-// The number of bytes in the font file header.
-#define FONT_FILE_HEADER_LEN      5
+// The characters of a run are composed at the end of the draw_buffer, clear
+// of the rows that the bitblt drivers build at the start of the buffer.
+#define FONT_RUN_MAX              64
+#define font_run_buffer           (&draw_buffer [SCREEN_MAX_WIDTH - FONT_RUN_MAX])
 
 // The font drawing mode
 static uint8_t font_draw_mode;
@@ -72,47 +92,125 @@ static uint8_t y_pos;
 static uint8_t font_bytes;
 // Width of a character in pixels (5 for default font)
 static uint8_t font_w;
-// Width of a character + space of font in pixels (6 for default font)
+// Width of a character + space on the screen (6 for default font)
 static uint8_t font_ws;
 // Height of a character in pixels (8 for default font)
 static uint8_t font_h;
 // Horizontal space to leave between characters
 static uint8_t font_space;
+// Integer scale of the characters on the screen
+static uint8_t font_scale;
+// Width of a character on the screen, font_w * font_scale
+static uint8_t font_cw;
+// Height of a character on the screen, font_h * font_scale
+static uint8_t font_ch;
+// Space between characters on the screen, font_space * font_scale
+static uint8_t font_cspace;
 // First valid character
 static uint8_t font_first_char;
 // Last valid character
 static uint8_t font_last_char;
 // The current font we are using
 static const char *font_ptr;
+// The glyph widths of the current font
+static const uint8_t *font_width_ptr;
+// Non-zero when the current font is packed.
+static uint8_t font_packed;
 // The last position we are using.
 static uint8_t font_xpos;
 // The last position we are using.
 static uint8_t font_ypos;
 // The start position we are using.
 static uint8_t font_start_xpos;
+#ifdef T6963_TEXT_LAYER
+// Non-zero when the characters are drawn on the hardware text layer.
+static uint8_t font_text;
+#else
+// Without the text layer the characters are always drawn on the graphics.
+#define font_text 0
+#endif
+// The current font number.
+static uint8_t font_num;
+
+// The text window of the cursor, the inclusive window coordinates.
+static uint8_t win_x0;
+static uint8_t win_y0;
+static uint8_t win_x1;
+static uint8_t win_y1;
+// The FONT_WINDOW_SCROLL and FONT_WINDOW_WRAP flags of the window.
+static uint8_t win_flags;
+
+#ifdef FONT_WINDOW
+// The selected window.
+static uint8_t font_window;
+
+// A text window. The cursor, font and mode of the window are saved while
+// another window is selected.
+typedef struct
+{
+    uint8_t x0;                         // The left x-coordinate
+    uint8_t y0;                         // The top y-coordinate
+    uint8_t x1;                         // The right x-coordinate
+    uint8_t y1;                         // The bottom y-coordinate
+    uint8_t flags;                      // The window flags
+    uint8_t x_pos;                      // The cursor x-coordinate
+    uint8_t y_pos;                      // The cursor y-coordinate
+    uint8_t start_xpos;                 // The start of the line
+    uint8_t font;                       // The font number
+    uint8_t mode;                       // The drawing mode
+} font_window_t;
+
+static font_window_t font_windows [FONT_WINDOW_NUM];
+#endif /* FONT_WINDOW */
+
+//////////////////////////////////////////////////////////////////////////////
+/// Compute the size of the character cell on the screen from the font and
+/// the drawing scale. The text layer is not scaled.
+///
+void
+font_cell (void)
+{
+    uint8_t scale = 1;
+
+    if (font_text == 0)
+        scale = drawing_scale;
+
+    // The space to the last character is not known at a new scale.
+    if (scale != font_scale)
+    {
+        font_scale = scale;
+        font_xpos = ~0;
+        font_ypos = ~0;
+    }
+    font_cw = font_w * font_scale;
+    font_ch = font_h * font_scale;
+    font_cspace = font_space * font_scale;
+    font_ws = font_cw + font_cspace;
+}
 
 //////////////////////////////////////////////////////////////////////////////
 /// Initialise the fonts.
 /// We install the fonts that we are using.
 ///
-/// @param [in] fptr Pointer to the font file in flash memory.
+/// @param [in] font The font number, see font_set().
 void
-font_init (const char *fptr)
+font_init (uint8_t font)
 {
+    const char *fptr;
     uint8_t temp_w;
     
-    // Use the default font if none specified
-    if (fptr == NULL)
-        fptr = font_alt_5x8;
-
-    // Set up the default font
+    // Set up the font and its glyph widths
+    fptr = (const char *)(pgm_read_word (&font_table [font]));
+    font_width_ptr = (const uint8_t *)(pgm_read_word (&font_width_table [font]));
     font_ptr = fptr;
+    font_num = font;
     temp_w = pgm_read_byte(fptr++);
     font_w = temp_w;
     font_h = pgm_read_byte(fptr++);
     font_bytes = (font_h + 7) / 8;      // 8 pixels/byte with partial rows
     font_space = pgm_read_byte(fptr++);
-    font_ws = temp_w + font_space;
+    font_packed = font_space & FONT_PACKED_FLAG;
+    font_space &= ~FONT_PACKED_FLAG;
     font_first_char = pgm_read_byte(fptr++);
     font_last_char = pgm_read_byte(fptr++);
     font_bytes *= temp_w;               // Need font_w stacks of rows
@@ -120,6 +218,12 @@ font_init (const char *fptr)
     // Reset the position
     font_xpos = ~0;
     font_ypos = ~0;
+
+#ifdef T6963_TEXT_LAYER
+    // Characters are drawn on the graphics.
+    font_text = 0;
+#endif
+    font_cell ();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -128,21 +232,17 @@ font_init (const char *fptr)
 /// @param [in] font The charaterset to use.
 ///                  0 = Default font 5x8
 ///                  1 = Small font 3x6
+///                  2 = Large numeric font 10x16 (FONT_LARGE)
+///                  3 = Seven segment numeric font 10x16 (FONT_LARGE)
 /// @param [in] cmd  The command. 0x08=store, 0x48
 void
 font_set (uint8_t font, uint8_t cmd)
 {
-    const char *fptr;
-    
     // Determine the font
-    font &= 1;
-    if (font == 0)
-        fptr = font_alt_5x8;
-    else
-        fptr = tom_thumb_3x6;
+    font %= FONT_NUM;
     
     // Initialise the font.
-    font_init(fptr);
+    font_init(font);
     
     // Save the setting if required.
     if (cmd == CMD_FONT_SET)
@@ -156,6 +256,210 @@ void
 font_mode (uint8_t mode)
 {
     font_draw_mode = mode;
+    font_cell ();
+}
+
+#ifdef T6963_TEXT_LAYER
+//////////////////////////////////////////////////////////////////////////////
+/// Enable or disable console output on the hardware text layer. The default
+/// font is loaded into the CG RAM when the text layer is enabled and the
+/// characters are then positioned on 8x8 cells.
+///
+/// @param [in] flags TEXT_LAYER_ON with options to enable, zero to disable.
+void
+font_text_layer (uint8_t flags)
+{
+    if (t6963_text_layer (flags) == 0)
+    {
+        // Return to the selected font on the graphics.
+        if (font_text != 0)
+            font_set (prefs_font, CMDX_FONT_SET);
+        return;
+    }
+
+    if (font_text == 0)
+    {
+        uint8_t buf [8];                // Character columns
+        uint8_t code;                   // Character code
+        uint8_t ii;
+
+        // Load the default font into the CG RAM.
+        font_init (0);
+        for (code = 0; code < (sizeof (font_alt_5x8) - FONT_FILE_HEADER_LEN) / font_bytes; code++)
+        {
+            for (ii = 0; ii < 8; ii++)
+            {
+                buf [ii] = 0;
+                if (ii < font_w)
+                    buf [ii] = pgm_read_byte (&font_ptr [(code * font_bytes) + FONT_FILE_HEADER_LEN + ii]);
+            }
+            t6963_text_glyph (code, buf);
+        }
+
+        // Each character takes a whole cell.
+        font_w = 7;
+        font_space = 1;
+        font_text = 1;
+        font_cell ();
+    }
+}
+#endif /* T6963_TEXT_LAYER */
+
+#ifdef FONT_WINDOW
+//////////////////////////////////////////////////////////////////////////////
+/// Make the selected window current. The cursor, font and mode of the window
+/// are restored, the text layer keeps its own font.
+///
+static void
+font_window_load (void)
+{
+    font_window_t *window = &font_windows [font_window];
+
+    win_x0 = window->x0;
+    win_y0 = window->y0;
+    win_x1 = window->x1;
+    win_y1 = window->y1;
+    win_flags = window->flags;
+    x_pos = window->x_pos;
+    y_pos = window->y_pos;
+    font_start_xpos = window->start_xpos;
+
+    if ((font_text == 0) && (window->font != font_num))
+        font_init (window->font);
+    font_mode (window->mode);
+
+    // Invalidate the previous position
+    font_xpos = ~0;
+    font_ypos = ~0;
+}
+
+#endif /* FONT_WINDOW */
+
+//////////////////////////////////////////////////////////////////////////////
+/// Initialise the text windows. Every window is the whole screen with the
+/// current font and mode, window 0 is selected. Without FONT_WINDOW the
+/// text is always drawn in the whole screen.
+///
+void
+font_window_init (void)
+{
+#ifdef FONT_WINDOW
+    uint8_t ii;
+
+    font_window = 0;
+    for (ii = 0; ii < FONT_WINDOW_NUM; ii++)
+        font_window_define (ii, 0, 0, x_dim - 1, y_dim - 1,
+                            FONT_WINDOW_SCROLL|FONT_WINDOW_WRAP);
+#else
+    win_x0 = 0;
+    win_y0 = 0;
+    win_x1 = x_dim - 1;
+    win_y1 = y_dim - 1;
+    win_flags = FONT_WINDOW_SCROLL|FONT_WINDOW_WRAP;
+    x_pos = 0;
+    y_pos = 0;
+    font_start_xpos = 0;
+#endif
+}
+
+#ifdef FONT_WINDOW
+
+//////////////////////////////////////////////////////////////////////////////
+/// Define a text window. The cursor of the window is moved to the top left
+/// and the window takes the current font and mode. When the window is
+/// selected then it takes effect immediately.
+///
+/// @param [in] id The window 0..FONT_WINDOW_NUM-1.
+/// @param [in] x0 The left x-coordinate.
+/// @param [in] y0 The top y-coordinate.
+/// @param [in] x1 The right x-coordinate.
+/// @param [in] y1 The bottom y-coordinate.
+/// @param [in] flags FONT_WINDOW_SCROLL and FONT_WINDOW_WRAP.
+void
+font_window_define (uint8_t id, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t flags)
+{
+    font_window_t *window;
+
+    if (id >= FONT_WINDOW_NUM)
+        return;
+
+    // Order the coordinates and clip to the screen.
+    if (x0 > x1)
+        swap_bytes (x0, x1);
+    if (y0 > y1)
+        swap_bytes (y0, y1);
+    if (x1 >= x_dim)
+        x1 = x_dim - 1;
+    if (y1 >= y_dim)
+        y1 = y_dim - 1;
+    if ((x0 > x1) || (y0 > y1))
+        return;
+
+    window = &font_windows [id];
+    window->x0 = x0;
+    window->y0 = y0;
+    window->x1 = x1;
+    window->y1 = y1;
+    window->flags = flags;
+    window->x_pos = x0;
+    window->y_pos = y0;
+    window->start_xpos = x0;
+    window->font = font_num;
+    window->mode = font_draw_mode;
+
+    if (id == font_window)
+        font_window_load ();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Select the text window that characters are drawn in. The cursor, font
+/// and mode of the current window are saved.
+///
+/// @param [in] id The window 0..FONT_WINDOW_NUM-1.
+void
+font_window_select (uint8_t id)
+{
+    font_window_t *window = &font_windows [font_window];
+
+    if (id >= FONT_WINDOW_NUM)
+        return;
+
+    window->x_pos = x_pos;
+    window->y_pos = y_pos;
+    window->start_xpos = font_start_xpos;
+    window->font = font_num;
+    window->mode = font_draw_mode;
+
+    font_window = id;
+    font_window_load ();
+}
+#endif /* FONT_WINDOW */
+
+//////////////////////////////////////////////////////////////////////////////
+/// Scroll the window up by a line of text. The whole screen uses the
+/// hardware scroll, a smaller window is copied. The text layer only scrolls
+/// with the whole screen.
+///
+/// @return Non-zero when the window is scrolled, zero when the text should
+///         wrap to the top of the window.
+static uint8_t
+font_scroll (void)
+{
+    if (!is_scroll() || ((win_flags & FONT_WINDOW_SCROLL) == 0))
+        return 0;
+
+#ifdef FONT_WINDOW
+    if ((win_x0 == 0) && (win_y0 == 0) &&
+        (win_x1 == x_dim - 1) && (win_y1 == y_dim - 1))
+        lcd_vscroll (draw_buffer, -(int8_t)(font_ch), prefs_reverse);
+    else if (font_text != 0)
+        return 0;
+    else
+        lcd_wscroll (win_x0, win_y0, win_x1, win_y1, font_ch, prefs_reverse);
+#else
+    lcd_vscroll (draw_buffer, -(int8_t)(font_ch), prefs_reverse);
+#endif
+    return 1;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -221,6 +525,30 @@ font_draw_number (int16_t value)
     while (*p != '\0');
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// Test if the blank columns of the characters are removed. The font is
+/// proportional and the font size is less than or equal to 8 pixels.
+///
+#define font_is_prop() \
+    (((font_draw_mode & MODE_PROP_FONT) != 0) && (font_h <= 8))
+
+//////////////////////////////////////////////////////////////////////////////
+/// Get the width of a character, blank columns are removed from a
+/// proportional font. The proportional widths are looked up in the width
+/// table of the font which is generated by fontgen.
+///
+/// @param [in] txt The character, within the font.
+///
+/// @return The number of columns of the character.
+///
+static uint8_t
+font_width (uint8_t txt)
+{
+    if (font_is_prop())
+        return pgm_read_byte (&font_width_ptr [txt - font_first_char]) & 0x0f;
+    return font_w;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /// Layout a string in the x-axis for labelling. This is used for
 /// proporitional fonts and computes the length of a 0xff terminated string
@@ -246,35 +574,20 @@ font_layout (uint8_t x, uint8_t y, uint8_t justification)
     // and collect characters. 
     while ((txt = serial_peek(count)) != 0xff)
     {
-        uint16_t ii;
-        uint16_t offset;
-        
         // Make sure the text is in bounds otherwise print a question mark.
         if ((txt < font_first_char) || (txt > font_last_char))
             txt = font_first_char;      // Correct out of bounds
         
-        // txt-32 is the ascii offset to 'space', font_bytes is the # of
-        // bytes/character, and 5 for font width,height,space, first_char and
-        // last_char which are stores at the beginning of the array
-        offset = (txt - font_first_char) * font_bytes + FONT_FILE_HEADER_LEN;
-        
-        // Compute the width of the character.
-        for (ii = offset; ii < offset + font_bytes; ii++)
-        {
-            uint8_t cc = pgm_read_byte (&font_ptr[ii]);
-            
-            // If the font is proportional then remove any blank verticals
-            // only if the character is not a space and the font size is less
-            // than or equal to 8 pixels. 
-            if ((cc != 0) || (txt == 0x20) || ((font_draw_mode & MODE_PROP_FONT) == 0) || (font_h > 8))
-            {
-                length++;
-            }
-        }
+        // Compute the width of the character. On the text layer every
+        // character takes a whole cell.
+        if (font_text != 0)
+            length += font_w;
+        else
+            length += font_width (txt) * font_scale;
         
         // Account for intercharacter space.
         if (count > 0)
-            length += font_space;
+            length += font_cspace;
         
         // Another character processed.
         count++;
@@ -294,49 +607,129 @@ font_layout (uint8_t x, uint8_t y, uint8_t justification)
 }
     
 //////////////////////////////////////////////////////////////////////////////
-/// Draw a character on the screen. The x_pos, y_pos define the top/left
-/// of the corner of the character and are automatically updated for the next
-/// character.
+/// Compose the columns of a character. Blank columns are removed from a
+/// proportional font. A font taller than 8 pixels is composed as bands of
+/// font_w columns.
+///
+/// @param [in] txt The character, within the font.
+/// @param [out] buf The buffer to compose the columns into, font_bytes.
+///
+/// @return The number of columns composed.
+///
+static uint8_t
+font_glyph (uint8_t txt, uint8_t *buf)
+{
+    uint16_t offset;                    // Offset into the text array
+
+    // A packed character is decoded from its runs.
+    if (font_packed != 0)
+    {
+        const char *src;                // The runs of the character
+        uint8_t *end = buf + font_bytes;
+
+        src = font_ptr + pgm_read_word ((const uint16_t *)
+            &font_ptr [FONT_FILE_HEADER_LEN + 2 * (txt - font_first_char)]);
+        while (buf < end)
+        {
+            uint8_t code = pgm_read_byte (src++);
+            uint8_t count = (code & 0x7f) + 1;
+
+            if ((code & 0x80) != 0)
+                memset (buf, pgm_read_byte (src++), count);
+            else
+            {
+                memcpy_P (buf, src, count);
+                src += count;
+            }
+            buf += count;
+        }
+        return font_w;
+    }
+
+    // txt-32 is the ascii offset to 'space', font_bytes is the # of
+    // bytes/character, and 5 for font width,height,space, first_char and
+    // last_char which are stores at the beginning of the array
+    offset = (txt - font_first_char) * font_bytes + FONT_FILE_HEADER_LEN;
+
+    // A proportional character without its full width starts at its first
+    // non-blank column, the remaining blank columns are skipped. Spaces
+    // keep the full width in the table.
+    if (font_is_prop())
+    {
+        uint8_t width;                  // The packed width
+        uint8_t jj;                     // Buffer position.
+
+        width = pgm_read_byte (&font_width_ptr [txt - font_first_char]);
+        offset += width >> 4;
+        width &= 0x0f;
+        if (width != font_w)
+        {
+            for (jj = 0; jj < width; offset++)
+            {
+                uint8_t cc = pgm_read_byte (&font_ptr[offset]);
+
+                if (cc != 0)
+                    buf[jj++] = cc;
+            }
+            return width;
+        }
+    }
+
+    // Copy one character worth of bytes
+    memcpy_P (buf, &font_ptr[offset], font_bytes);
+    return font_w;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Draw a character, or a run of characters from the serial input, on the
+/// screen. The x_pos, y_pos define the top/left of the corner of the
+/// character and are automatically updated for the next character.
+///
+/// A run continues with the printable characters that have already been
+/// received, up to a command, a control character, the end of the line or
+/// FONT_RUN_MAX columns. The characters and the space between them are
+/// composed in the draw_buffer and drawn with a single bitblt.
 ///
 /// @param [in] txt The character to draw.
 ///                 If the character is not present we present a square box.
+/// @param [in] run Non-zero to continue with the characters that follow.
 ///
-void
-font_draw (char txt)
+static void
+font_render (uint8_t txt, uint8_t run)
 {
-    uint16_t offset;                    // Offset into the text array
-    uint16_t ii;                        // Loop counter.
-    uint8_t jj;                         // Buffer position.
     uint8_t mode;                       // The rendering mode.
-    uint8_t bltpos;                     // The bit blit position
-    uint8_t actual_width;               // The actual width 
-    
+    uint8_t xstart;                     // The first column of the run
+    uint8_t width;                      // The columns of the run
+    uint8_t wrap;                       // The run ends with a line feed
+
     // Quit quickly on character 0xff which is a terminal character for the
     // text layout. 
-    if (~txt == 0)
+    if (txt == 0xff)
         return;
     
     // y_pos counts pixels from the top of the screen
     // x_pos counts pixels from the left side of the screen
     
-    // A delayed LF, if the character position is off screen then wrap the
-    // position to the top of the screen or scroll the screen up. 
-    if (y_pos > (y_dim - font_h))
+    // Discard the characters beyond the right of a window that does not
+    // wrap.
+    if (x_pos > win_x1)
+        return;
+
+    // A delayed LF, if the character position is off the window then wrap
+    // the position to the top of the window or scroll the window up. 
+    if (y_pos + font_ch > win_y1 + 1)
     {
         // See if we need to scroll
-        if (is_scroll())
+        if (font_scroll ())
         {
-            // Scroll the screen up by 1 line.
-            lcd_vscroll (draw_buffer, -8, prefs_reverse);
-            
             // Decrement the font position.
-            y_pos -= font_h;
+            y_pos -= font_ch;
         }
         else
         {
             // Make sure that the line restarted at the top will overlap the
             // old one 
-            y_pos = y_pos % font_h;
+            y_pos = win_y0 + (uint8_t)(y_pos - win_y0) % font_ch;
         }
         
         // Invalidate the previous position
@@ -348,65 +741,126 @@ font_draw (char txt)
     mode = (~font_draw_mode ^ prefs_reverse) & MODE_NORMAL_MASK;
     mode |= font_draw_mode & ~MODE_NORMAL_MASK;
 
-    // Make sure the text is in bounds otherwise print a question mark.
-    if ((txt < font_first_char) || (txt > font_last_char))
-        txt = font_first_char;          // Correct out of bounds
-
-    // Get data for character. Put in upper half of buffer, lower half is
-    // used by bitblt
-    bltpos = SCREEN_MAX_WIDTH - font_bytes;
-    jj = bltpos;
+    // Columns are only concatenated for fonts of a single byte height.
+    if (font_h > 8)
+        run = 0;
 
-    // txt-32 is the ascii offset to 'space', font_bytes is the # of
-    // bytes/character, and 5 for font width,height,space, first_char and
-    // last_char which are stores at the beginning of the array
-    offset = (txt - font_first_char) * font_bytes + FONT_FILE_HEADER_LEN;
-    
-    // loop for one character worth of bytes
-    actual_width = 0;
-    for (ii = offset; ii < offset + font_bytes; ii++)
+    // See if we need to insert some space between the last character.
+    xstart = x_pos;
+    width = 0;
+    if ((font_text == 0) && (font_space > 0) && (x_pos > font_cspace) &&
+        (font_xpos == x_pos) && (font_ypos == y_pos))
     {
-        uint8_t cc = pgm_read_byte (&font_ptr[ii]);
-        
-        // If the font is proportional then remove any blank verticals only
-        // if the character is not a space and the font size is less than or
-        // equal to 8 pixels. 
-        if ((cc != 0) || (txt == 0x20) || ((font_draw_mode & MODE_PROP_FONT) == 0) || (font_h > 8))
+        if (font_h > 8)
+        {
+            uint8_t data = 0x00;
+            draw_scaled_vbitblt (x_pos - font_cspace, y_pos, font_space,
+                                 font_h, mode | MODE_FILL, font_scale, &data);
+        }
+        else
         {
-            font_buffer[jj++] = cc;
-            actual_width++;
+            // Start the run with the space.
+            xstart -= font_cspace;
+            width = font_space;
+            memset (font_run_buffer, 0, font_space);
         }
     }
 
-    // See if we need to insert some space between the last character.
-    if ((font_space > 0) && (x_pos > font_space) &&
-        (font_xpos == x_pos) && (font_ypos == y_pos))
+    for (;;)
     {
-        uint8_t data = 0x00;
-        lcd_vbitblt (x_pos - font_space, y_pos,
-                     font_space, font_h, mode | MODE_FILL, &data);
-    }
+        uint8_t actual_width;           // The actual width
 
-    // Render the character to the screen.
-    lcd_vbitblt (x_pos, y_pos, actual_width, font_h, mode, &font_buffer[bltpos]);
+        // Make sure the text is in bounds otherwise print a question mark.
+        if ((txt < font_first_char) || (txt > font_last_char))
+            txt = font_first_char;      // Correct out of bounds
 
-    // Advance the current cursor position.
-    x_pos += actual_width + font_space;
+#ifdef T6963_TEXT_LAYER
+        // The hardware text layer draws the character with a single write.
+        if (font_text != 0)
+        {
+            t6963_text_draw (x_pos, y_pos, txt - font_first_char, mode);
+            actual_width = font_w;
+            run = 0;
+        }
+        else
+#endif
+        {
+            actual_width = font_glyph (txt, &font_run_buffer [width]);
+            width += actual_width;
+        }
+
+        // Advance the current cursor position.
+        x_pos += (actual_width + font_space) * font_scale;
+
+        // Check x offset and do necessary wrapping
+        wrap = ((x_pos + font_cw) > win_x1);
+        if (wrap)
+        {
+            // Make sure text on the next line will line up with the
+            // previous line, the line feed follows the draw. Without
+            // wrapping the rest of the line is discarded.
+            if ((win_flags & FONT_WINDOW_WRAP) == 0)
+            {
+                x_pos = win_x1 + 1;
+                wrap = 0;
+            }
+            else
+                x_pos = font_start_xpos; /*%= font_ws*/;
+            break;
+        }
 
-    // Check x offset and do necessary wrapping
-    if ((x_pos + font_w) > x_dim - 1)
-    {
-        // Make sure text on the next line will line up with the previous
-        // line and perform a line feed operation.
-        x_pos = font_start_xpos; /*%= font_ws*/;
-        font_lf ();
-    }
-    else
-    {
         // Save the last position.
         font_xpos = x_pos;
         font_ypos = y_pos;
+
+        // Continue the run with the next character if it has arrived, is
+        // printable and there is room for it and the space before it.
+        if ((run == 0) || (serial_ready () == 0) ||
+            ((uint8_t)(width + font_space + font_bytes) > FONT_RUN_MAX))
+            break;
+        txt = serial_peek (0);
+        if ((txt < ' ') || (txt == CHAR_COMMAND) || (txt == 0xff))
+            break;
+        txt = serial_getc ();
+
+        memset (&font_run_buffer [width], 0, font_space);
+        width += font_space;
     }
+
+    // Render the characters to the screen.
+    if (width > 0)
+        draw_scaled_vbitblt (xstart, y_pos, width, font_h, mode, font_scale,
+                             font_run_buffer);
+
+    // Perform the line feed of a wrap.
+    if (wrap)
+        font_lf ();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Draw a character on the screen. The x_pos, y_pos define the top/left
+/// of the corner of the character and are automatically updated for the next
+/// character.
+///
+/// @param [in] txt The character to draw.
+///                 If the character is not present we present a square box.
+///
+void
+font_draw (char txt)
+{
+    font_render (txt, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Draw a character received from the serial input followed by the run of
+/// printable characters that have already been received, see font_render().
+///
+/// @param [in] txt The character to draw.
+///
+void
+font_draw_run (char txt)
+{
+    font_render (txt, 1);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -416,18 +870,18 @@ font_draw (char txt)
 void
 font_backspace (void)
 {
-    if (x_pos < font_ws)
+    if (x_pos < win_x0 + font_ws)
     {
         // If previous char wouldn't have fit
-        x_pos = (x_dim - font_ws - ((x_dim - x_pos) % font_ws));
+        x_pos = (win_x1 + 1 - font_ws - ((uint8_t)(win_x1 + 1 - x_pos) % font_ws));
 
-        if (y_pos < font_h)
+        if (y_pos < win_y0 + font_ch)
         {
-            // If we run off the top of the screen
-            y_pos = (y_dim - font_h - ((y_dim - y_pos) % font_h));
+            // If we run off the top of the window
+            y_pos = (win_y1 + 1 - font_ch - ((uint8_t)(win_y1 + 1 - y_pos) % font_ch));
         }
         else
-            y_pos -= font_h;
+            y_pos -= font_ch;
     }
     else
     {
@@ -436,11 +890,19 @@ font_backspace (void)
         x_pos -= font_ws;
     }
 
-    // Erase the block
-    fill_box (x_pos, y_pos,
-              x_pos + font_w,
-              y_pos + font_h - 1,
-              ~prefs_reverse & MODE_NORMAL_MASK);
+    // Erase the block. The text is not moved by the drawing origin so the
+    // block is filled at the screen position rather than with fill_box().
+#ifdef T6963_TEXT_LAYER
+    if (font_text != 0)
+        t6963_text_draw (x_pos, y_pos, 0, ~prefs_reverse & MODE_NORMAL_MASK);
+    else
+#endif
+    {
+        uint8_t data = 0xff;
+
+        draw_scaled_vbitblt (x_pos, y_pos, font_cw + 1, font_ch,
+                             MODE_REVERSE | MODE_FILL, 1, &data);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -465,20 +927,16 @@ void
 font_lf (void)
 {
     // Handle a new line additional scroll, determine if we need to scroll.
-    if (y_pos >= y_dim) 
+    if (y_pos > win_y1) 
     {
-        if (is_scroll())
-        {
-            // There is a scroll pending when we render the next character. To
-            // provide an interactive feedback then perform a scroll now. Scroll
-            // the screen up by 1 line. 
-            lcd_vscroll (draw_buffer, -8, prefs_reverse);
-        }
-        else
+        // There is a scroll pending when we render the next character. To
+        // provide an interactive feedback then perform a scroll now. Scroll
+        // the window up by 1 line. 
+        if (font_scroll () == 0)
         {
             // Make sure that the line restarted at the top will overlap the
             // old one 
-            y_pos %= font_h;
+            y_pos = win_y0 + (uint8_t)(y_pos - win_y0) % font_ch;
         }
     }
     else
@@ -486,7 +944,7 @@ font_lf (void)
         // Advance the line offset, note that this is not enacted until the next
         // character is draw so that we keep as much information on the screen as
         // possible in the case that we scroll.
-        y_pos += font_h;
+        y_pos += font_ch;
     }
     
     // If there is LF preference then enact.
@@ -499,7 +957,8 @@ font_lf (void)
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// Modify the x and y position
+/// Modify the x and y position, the position is relative to the top left of
+/// the window.
 ///
 void
 font_position (uint8_t arg1, uint8_t arg2, uint8_t cmd)
@@ -507,18 +966,18 @@ font_position (uint8_t arg1, uint8_t arg2, uint8_t cmd)
     if (cmd == CMD_SET_Y_OFFSET)
     {
         // Y offset change only
-        y_pos = arg1;
+        y_pos = win_y0 + arg1;
     }
     else
     {
         // Set the x position
-        x_pos = arg1;
-        font_start_xpos = arg1;
+        x_pos = win_x0 + arg1;
+        font_start_xpos = x_pos;
         
         // If this is not an x offset only then set the y position with the
         // 2nd argument. 
         if (cmd != CMD_SET_X_OFFSET)
-            y_pos = arg2;
+            y_pos = win_y0 + arg2;
     }
     
     // Invalidate the previous position
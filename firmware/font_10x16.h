@@ -0,0 +1,551 @@
+// A large 10x16 font for numbers
+// Digits, ' ', '+', ',', '-', '.', '/' and ':' for readouts that are seen
+// from a distance.
+//
+// The characters are stored as two bands of 10 columns, the top 8 rows
+// followed by the bottom 8 rows. Characters without a glyph are blank.
+// The font is compressed by fontgen when it is built into the firmware.
+//
+static const char font_10x16[545] PROGMEM = {
+    0x0a,0x10,0x02,' ', ':',/*font_w, font_h, font_space, '1st char (space)', 'last_char(:)' */
+    /* space - Char = ' '/32/0x20
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ! - Char = '!'/33/0x21
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* " - Char = '"'/34/0x22
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* # - Char = '#'/35/0x23
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* $ - Char = '$'/36/0x24
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* % - Char = '%'/37/0x25
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* & - Char = '&'/38/0x26
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ' - Char = '''/39/0x27
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ( - Char = '('/40/0x28
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ) - Char = ')'/41/0x29
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* * - Char = '*'/42/0x2a
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* + - Char = '+'/43/0x2b
+     * ..........
+     * ..........
+     * ..........
+     * ....**....
+     * ....**....
+     * ....**....
+     * .********.
+     * .********.
+     * ....**....
+     * ....**....
+     * ....**....
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0xc0,0xc0,0xc0,0xf8,0xf8,0xc0,0xc0,0xc0,0x00,
+    0x00,0x00,0x00,0x00,0x07,0x07,0x00,0x00,0x00,0x00,
+    /* , - Char = ','/44/0x2c
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ...***....
+     * ...***....
+     * ....**....
+     * ...**.....
+     * ..**......
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x80,0xd8,0x78,0x38,0x00,0x00,0x00,0x00,
+    /* - - Char = '-'/45/0x2d
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * .********.
+     * .********.
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* . - Char = '.'/46/0x2e
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ...***....
+     * ...***....
+     * ...***....
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x38,0x38,0x38,0x00,0x00,0x00,0x00,
+    /* / - Char = '/'/47/0x2f
+     * ........**
+     * .......**.
+     * .......**.
+     * ......**..
+     * ......**..
+     * .....**...
+     * .....**...
+     * ....**....
+     * ....**....
+     * ...**.....
+     * ...**.....
+     * ..**......
+     * ..**......
+     * .**.......
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x80,0xe0,0x78,0x1e,0x07,0x01,
+    0x00,0x20,0x38,0x1e,0x07,0x01,0x00,0x00,0x00,0x00,
+    /* 0 - Char = '0'/48/0x30
+     * ...****...
+     * .********.
+     * .***..***.
+     * **......**
+     * **.....***
+     * **....****
+     * **...**.**
+     * **.**...**
+     * ****....**
+     * ***.....**
+     * **......**
+     * .***..***.
+     * .********.
+     * ...****...
+     * ..........
+     * ..........
+     */
+    0xf8,0xfe,0x06,0x87,0x83,0x43,0x67,0x36,0xfe,0xf8,
+    0x07,0x1f,0x1b,0x39,0x30,0x30,0x38,0x18,0x1f,0x07,
+    /* 1 - Char = '1'/49/0x31
+     * ....**....
+     * ...***....
+     * .*****....
+     * .**.**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * .********.
+     * .********.
+     * ..........
+     * ..........
+     */
+    0x00,0x0c,0x0c,0x06,0xff,0xff,0x00,0x00,0x00,0x00,
+    0x00,0x30,0x30,0x30,0x3f,0x3f,0x30,0x30,0x30,0x00,
+    /* 2 - Char = '2'/50/0x32
+     * ..*****...
+     * .*******..
+     * ***...***.
+     * **.....**.
+     * .......**.
+     * ......***.
+     * .....***..
+     * ....***...
+     * ...***....
+     * ..***.....
+     * .***......
+     * ***.......
+     * *********.
+     * *********.
+     * ..........
+     * ..........
+     */
+    0x0c,0x0e,0x07,0x03,0x83,0xc3,0xe7,0x7e,0x3c,0x00,
+    0x38,0x3c,0x3e,0x37,0x33,0x31,0x30,0x30,0x30,0x00,
+    /* 3 - Char = '3'/51/0x33
+     * ..*****...
+     * .*******..
+     * ***...***.
+     * .......**.
+     * .......**.
+     * ......***.
+     * ...*****..
+     * ...******.
+     * .......***
+     * ........**
+     * **......**
+     * ***....***
+     * .********.
+     * ..******..
+     * ..........
+     * ..........
+     */
+    0x04,0x06,0x07,0xc3,0xc3,0xc3,0xe7,0xfe,0xbc,0x00,
+    0x0c,0x1c,0x38,0x30,0x30,0x30,0x30,0x39,0x1f,0x0f,
+    /* 4 - Char = '4'/52/0x34
+     * ......**..
+     * .....***..
+     * ....****..
+     * ...**.**..
+     * ..**..**..
+     * .**...**..
+     * **....**..
+     * **....**..
+     * **********
+     * **********
+     * ......**..
+     * ......**..
+     * ......**..
+     * ......**..
+     * ..........
+     * ..........
+     */
+    0xc0,0xe0,0x30,0x18,0x0c,0x06,0xff,0xff,0x00,0x00,
+    0x03,0x03,0x03,0x03,0x03,0x03,0x3f,0x3f,0x03,0x03,
+    /* 5 - Char = '5'/53/0x35
+     * *********.
+     * *********.
+     * **........
+     * **........
+     * **........
+     * ********..
+     * *********.
+     * .......***
+     * ........**
+     * ........**
+     * **......**
+     * ***....***
+     * .********.
+     * ..******..
+     * ..........
+     * ..........
+     */
+    0x7f,0x7f,0x63,0x63,0x63,0x63,0x63,0xe3,0xc3,0x80,
+    0x0c,0x1c,0x38,0x30,0x30,0x30,0x30,0x38,0x1f,0x0f,
+    /* 6 - Char = '6'/54/0x36
+     * ...*****..
+     * ..******..
+     * .***......
+     * ***.......
+     * **........
+     * **.****...
+     * *********.
+     * ***....***
+     * **......**
+     * **......**
+     * **......**
+     * ***....***
+     * .********.
+     * ..******..
+     * ..........
+     * ..........
+     */
+    0xf8,0xfc,0xce,0x67,0x63,0x63,0x63,0xc3,0xc0,0x80,
+    0x0f,0x1f,0x38,0x30,0x30,0x30,0x30,0x38,0x1f,0x0f,
+    /* 7 - Char = '7'/55/0x37
+     * **********
+     * **********
+     * ........**
+     * .......***
+     * .......**.
+     * ......***.
+     * ......**..
+     * .....***..
+     * .....**...
+     * ....***...
+     * ....**....
+     * ....**....
+     * ....**....
+     * ....**....
+     * ..........
+     * ..........
+     */
+    0x03,0x03,0x03,0x03,0x03,0x83,0xe3,0xfb,0x3f,0x0f,
+    0x00,0x00,0x00,0x00,0x3e,0x3f,0x03,0x00,0x00,0x00,
+    /* 8 - Char = '8'/56/0x38
+     * ..******..
+     * .********.
+     * ***....***
+     * **......**
+     * ***....***
+     * .********.
+     * ..******..
+     * .********.
+     * ***....***
+     * **......**
+     * **......**
+     * ***....***
+     * .********.
+     * ..******..
+     * ..........
+     * ..........
+     */
+    0x1c,0xbe,0xf7,0xe3,0xe3,0xe3,0xe3,0xf7,0xbe,0x1c,
+    0x0f,0x1f,0x39,0x30,0x30,0x30,0x30,0x39,0x1f,0x0f,
+    /* 9 - Char = '9'/57/0x39
+     * ..******..
+     * .********.
+     * ***....***
+     * **......**
+     * **......**
+     * **......**
+     * ***....***
+     * .*********
+     * ...****.**
+     * ........**
+     * .......***
+     * ......***.
+     * ..******..
+     * ..*****...
+     * ..........
+     * ..........
+     */
+    0x7c,0xfe,0xc7,0x83,0x83,0x83,0x83,0xc7,0xfe,0xfc,
+    0x00,0x00,0x30,0x31,0x31,0x31,0x39,0x1c,0x0f,0x07,
+    /* : - Char = ':'/58/0x3a
+     * ..........
+     * ..........
+     * ..........
+     * ...***....
+     * ...***....
+     * ...***....
+     * ..........
+     * ..........
+     * ..........
+     * ...***....
+     * ...***....
+     * ...***....
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x38,0x38,0x38,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x0e,0x0e,0x0e,0x00,0x00,0x00,0x00
+};
@@ -0,0 +1,550 @@
+// A 10x16 seven segment style font for numbers
+// Digits, ' ', '-', '.' and ':' for readouts that are seen from a distance.
+//
+// The characters are stored as two bands of 10 columns, the top 8 rows
+// followed by the bottom 8 rows. Characters without a glyph are blank.
+// The font is compressed by fontgen when it is built into the firmware.
+//
+static const char font_7seg_10x16[545] PROGMEM = {
+    0x0a,0x10,0x02,' ', ':',/*font_w, font_h, font_space, '1st char (space)', 'last_char(:)' */
+    /* space - Char = ' '/32/0x20
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ! - Char = '!'/33/0x21
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* " - Char = '"'/34/0x22
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* # - Char = '#'/35/0x23
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* $ - Char = '$'/36/0x24
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* % - Char = '%'/37/0x25
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* & - Char = '&'/38/0x26
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ' - Char = '''/39/0x27
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ( - Char = '('/40/0x28
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* ) - Char = ')'/41/0x29
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* * - Char = '*'/42/0x2a
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* + - Char = '+'/43/0x2b
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* , - Char = ','/44/0x2c
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* - - Char = '-'/45/0x2d
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..******..
+     * ..******..
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x80,0x80,0x80,0x80,0x80,0x80,0x00,0x00,
+    0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x00,0x00,
+    /* . - Char = '.'/46/0x2e
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ...**.....
+     * ...**.....
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,
+    /* / - Char = '/'/47/0x2f
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    /* 0 - Char = '0'/48/0x30
+     * ..******..
+     * ..******..
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..........
+     * ..........
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..******..
+     * ..******..
+     */
+    0x7c,0x7c,0x03,0x03,0x03,0x03,0x03,0x03,0x7c,0x7c,
+    0x3e,0x3e,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x3e,0x3e,
+    /* 1 - Char = '1'/49/0x31
+     * ..........
+     * ..........
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..........
+     * ..........
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7c,0x7c,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3e,0x3e,
+    /* 2 - Char = '2'/50/0x32
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..******..
+     * ..******..
+     * **........
+     * **........
+     * **........
+     * **........
+     * **........
+     * ..******..
+     * ..******..
+     */
+    0x00,0x00,0x83,0x83,0x83,0x83,0x83,0x83,0x7c,0x7c,
+    0x3e,0x3e,0xc1,0xc1,0xc1,0xc1,0xc1,0xc1,0x00,0x00,
+    /* 3 - Char = '3'/51/0x33
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..******..
+     * ..******..
+     */
+    0x00,0x00,0x83,0x83,0x83,0x83,0x83,0x83,0x7c,0x7c,
+    0x00,0x00,0xc1,0xc1,0xc1,0xc1,0xc1,0xc1,0x3e,0x3e,
+    /* 4 - Char = '4'/52/0x34
+     * ..........
+     * ..........
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..........
+     * ..........
+     */
+    0x7c,0x7c,0x80,0x80,0x80,0x80,0x80,0x80,0x7c,0x7c,
+    0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x3e,0x3e,
+    /* 5 - Char = '5'/53/0x35
+     * ..******..
+     * ..******..
+     * **........
+     * **........
+     * **........
+     * **........
+     * **........
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..******..
+     * ..******..
+     */
+    0x7c,0x7c,0x83,0x83,0x83,0x83,0x83,0x83,0x00,0x00,
+    0x00,0x00,0xc1,0xc1,0xc1,0xc1,0xc1,0xc1,0x3e,0x3e,
+    /* 6 - Char = '6'/54/0x36
+     * ..******..
+     * ..******..
+     * **........
+     * **........
+     * **........
+     * **........
+     * **........
+     * ..******..
+     * ..******..
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..******..
+     * ..******..
+     */
+    0x7c,0x7c,0x83,0x83,0x83,0x83,0x83,0x83,0x00,0x00,
+    0x3e,0x3e,0xc1,0xc1,0xc1,0xc1,0xc1,0xc1,0x3e,0x3e,
+    /* 7 - Char = '7'/55/0x37
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..........
+     * ..........
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0x7c,0x7c,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3e,0x3e,
+    /* 8 - Char = '8'/56/0x38
+     * ..******..
+     * ..******..
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..******..
+     * ..******..
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..******..
+     * ..******..
+     */
+    0x7c,0x7c,0x83,0x83,0x83,0x83,0x83,0x83,0x7c,0x7c,
+    0x3e,0x3e,0xc1,0xc1,0xc1,0xc1,0xc1,0xc1,0x3e,0x3e,
+    /* 9 - Char = '9'/57/0x39
+     * ..******..
+     * ..******..
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * **......**
+     * ..******..
+     * ..******..
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ........**
+     * ..******..
+     * ..******..
+     */
+    0x7c,0x7c,0x83,0x83,0x83,0x83,0x83,0x83,0x7c,0x7c,
+    0x00,0x00,0xc1,0xc1,0xc1,0xc1,0xc1,0xc1,0x3e,0x3e,
+    /* : - Char = ':'/58/0x3a
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ....**....
+     * ....**....
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     * ....**....
+     * ....**....
+     * ..........
+     * ..........
+     * ..........
+     * ..........
+     */
+    0x00,0x00,0x00,0x00,0x30,0x30,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x0c,0x0c,0x00,0x00,0x00,0x00
+};
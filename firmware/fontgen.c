@@ -0,0 +1,271 @@
+/* -*- c++ -*- ***************************************************************
+ *
+ *  System      : Serial GLCD
+ *  Module      : Font table generator
+ *
+ *  Description : Host tool that generates the proportional glyph width
+ *                tables and the packed fonts of the fonts in fonts.h.
+ *
+ *  Notes       : This is built and run on the host by the Makefile, the
+ *                output is written to fonttable.h. Each glyph has one byte
+ *                holding the first non-blank column in the upper nibble and
+ *                the number of non-blank columns in the lower nibble. A
+ *                space keeps the full width of the font. Fonts taller than
+ *                8 pixels are not proportional and their entries are 0.
+ *
+ *                A packed font is written as <name>_packed in the format
+ *                described by FONT_PACKED_FLAG, identical characters share
+ *                their encoding. Packed fonts have no width table and are
+ *                only built into the firmware with FONT_LARGE.
+ *
+ *  History     :
+ *
+ *****************************************************************************
+ *
+ *  Part of the Serial GLCD firmware, distributed under the MIT license in
+ *  LICENSE.txt.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The font files are placed in flash on the target.
+#define PROGMEM
+
+// Include the font files of the packed fonts.
+#define FONTGEN
+
+#include "fonts.h"
+
+// A font of the font list.
+typedef struct
+{
+    const char *name;                   // The name of the font array
+    const unsigned char *font;          // The font file
+    unsigned int size;                  // The size of the font file
+    int packed;                         // Non-zero to pack the font
+} font_t;
+
+#define FONT(name) { #name, (const unsigned char *) name, sizeof (name), 0 },
+#define FONT_PACKED(name) { #name, (const unsigned char *) name, sizeof (name), 1 },
+static const font_t fonts [] = { FONT_LIST };
+#undef FONT
+#undef FONT_PACKED
+
+/////////////////////////////////////////////////////////////////////////////
+/// Run length encode the bytes of a character. Runs of 3 or more bytes are
+/// repeated, the other bytes are literal.
+///
+/// @param [in] src The bytes of the character.
+/// @param [in] length The number of bytes.
+/// @param [out] dst The buffer for the encoding, 2 * length bytes.
+///
+/// @return The length of the encoding.
+static unsigned int
+font_encode (const unsigned char *src, unsigned int length, unsigned char *dst)
+{
+    unsigned int ii = 0;                // Source position
+    unsigned int jj = 0;                // Encoding position
+    unsigned int literal = 0;           // Position of the literal code
+
+    while (ii < length)
+    {
+        unsigned int run = 1;
+
+        while ((ii + run < length) && (run < 128) && (src [ii + run] == src [ii]))
+            run++;
+
+        if (run >= 3)
+        {
+            dst [jj++] = 0x80 | (run - 1);
+            dst [jj++] = src [ii];
+            ii += run;
+            literal = 0;
+        }
+        else
+        {
+            // Extend the current literal or start a new one.
+            if ((literal == 0) || (dst [literal - 1] == 0x7f))
+            {
+                dst [jj++] = 0x00;
+                literal = jj;
+            }
+            else
+                dst [literal - 1]++;
+            dst [jj++] = src [ii++];
+        }
+    }
+    return jj;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Generate the packed copy of a font.
+///
+/// @param [in] font The font to pack.
+///
+/// @return 0 on success otherwise 1 when the font cannot be packed.
+static int
+font_pack (const font_t *font)
+{
+    static unsigned char data [0x10000];
+    unsigned int font_bytes;            // The bytes of a character
+    unsigned int count;                 // Number of characters
+    unsigned int length;                // Length of the packed font
+    unsigned int code;                  // Character code
+    unsigned int ii;
+
+    font_bytes = ((font->font [1] + 7) / 8) * font->font [0];
+    count = font->font [4] - font->font [3] + 1;
+    if ((font->font [1] <= 8) || (font->font [2] >= FONT_PACKED_FLAG) ||
+        (font->size < FONT_FILE_HEADER_LEN + count * font_bytes))
+    {
+        fprintf (stderr, "fontgen: %s cannot be packed\n", font->name);
+        return 1;
+    }
+
+    // The header and the offset of each character.
+    memcpy (data, font->font, FONT_FILE_HEADER_LEN);
+    data [2] |= FONT_PACKED_FLAG;
+    length = FONT_FILE_HEADER_LEN + 2 * count;
+    for (code = 0; code < count; code++)
+    {
+        unsigned int offset;            // Offset of the character
+        unsigned int size;              // Size of the encoding
+
+        size = font_encode (&font->font [FONT_FILE_HEADER_LEN + code * font_bytes],
+                            font_bytes, &data [length]);
+
+        // Share the encoding of an identical character.
+        for (ii = 0; ii < code; ii++)
+        {
+            offset = data [FONT_FILE_HEADER_LEN + 2 * ii] |
+                (data [FONT_FILE_HEADER_LEN + 2 * ii + 1] << 8);
+            if (memcmp (&font->font [FONT_FILE_HEADER_LEN + ii * font_bytes],
+                        &font->font [FONT_FILE_HEADER_LEN + code * font_bytes],
+                        font_bytes) == 0)
+                break;
+        }
+        if (ii == code)
+        {
+            offset = length;
+            length += size;
+        }
+
+        data [FONT_FILE_HEADER_LEN + 2 * code] = offset & 0xff;
+        data [FONT_FILE_HEADER_LEN + 2 * code + 1] = offset >> 8;
+        if (length > sizeof (data) - 2 * font_bytes)
+        {
+            fprintf (stderr, "fontgen: %s is too large\n", font->name);
+            return 1;
+        }
+    }
+
+    printf ("// The packed copy of %s, %u bytes from %u.\n",
+            font->name, length, font->size);
+    printf ("static const char %s_packed [%u] PROGMEM = {", font->name, length);
+    for (ii = 0; ii < length; ii++)
+    {
+        if ((ii % 12) == 0)
+            printf ("\n   ");
+        printf (" 0x%02x,", data [ii]);
+    }
+    printf ("\n};\n\n");
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Generate the width table of a font.
+///
+/// @param [in] font The font to generate.
+///
+/// @return 0 on success otherwise 1 when the font cannot be tabulated.
+static int
+font_table (const font_t *font)
+{
+    unsigned int font_w;                // Width of a character
+    unsigned int font_h;                // Height of a character
+    unsigned int font_bytes;            // The bytes of a character
+    unsigned int first_char;            // First valid character
+    unsigned int last_char;             // Last valid character
+    unsigned int code;                  // Character code
+
+    font_w = font->font [0];
+    font_h = font->font [1];
+    first_char = font->font [3];
+    last_char = font->font [4];
+    font_bytes = ((font_h + 7) / 8) * font_w;
+
+    if ((font_h <= 8) && (font_w > 15))
+    {
+        fprintf (stderr, "fontgen: %s is too wide for a width table\n",
+                 font->name);
+        return 1;
+    }
+
+    printf ("// The proportional widths of %s, first column << 4 | columns.\n",
+            font->name);
+    printf ("static const uint8_t %s_width [%u] PROGMEM = {",
+            font->name, last_char - first_char + 1);
+
+    for (code = first_char; code <= last_char; code++)
+    {
+        unsigned int offset;            // The offset of the character
+        unsigned int start = 0;         // First non-blank column
+        unsigned int width = 0;         // Number of non-blank columns
+        unsigned int ii;
+
+        offset = (code - first_char) * font_bytes + FONT_FILE_HEADER_LEN;
+        if (font_h > 8)
+            ;                           // Not proportional
+        else if ((code == 0x20) || (offset + font_bytes > font->size))
+            width = font_w;             // Space or missing character
+        else
+        {
+            for (ii = 0; ii < font_w; ii++)
+            {
+                if (font->font [offset + ii] == 0)
+                    continue;
+                if (width++ == 0)
+                    start = ii;
+            }
+        }
+
+        if (((code - first_char) % 8) == 0)
+            printf ("\n   ");
+        printf (" 0x%02x,", (start << 4) | width);
+    }
+    printf ("\n};\n\n");
+    return 0;
+}
+
+int
+main (void)
+{
+    unsigned int ii;
+
+    printf ("// Generated by fontgen from the fonts in fonts.h, do not edit.\n\n");
+    printf ("#ifndef __FONTTABLE_H\n");
+    printf ("#define __FONTTABLE_H\n\n");
+
+    for (ii = 0; ii < sizeof (fonts) / sizeof (fonts [0]); ii++)
+    {
+        if (fonts [ii].packed != 0)
+            printf ("#ifdef FONT_LARGE\n\n");
+        if (fonts [ii].packed == 0)
+        {
+            if (font_table (&fonts [ii]) != 0)
+                return EXIT_FAILURE;
+        }
+        else
+        {
+            if (font_pack (&fonts [ii]) != 0)
+                return EXIT_FAILURE;
+            printf ("#endif /* FONT_LARGE */\n\n");
+        }
+    }
+
+    printf ("#endif /* __FONTTABLE_H */\n");
+    return EXIT_SUCCESS;
+}
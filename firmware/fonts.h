@@ -0,0 +1,64 @@
+/* -*- c++ -*- ***************************************************************
+ *
+ *  System      : Serial GLCD
+ *  Module      : Font list
+ *
+ *  Description : The fonts that are built into the firmware.
+ *
+ *  Notes       : The list is shared by the firmware and the fontgen host
+ *                tool which generates the glyph width tables and the packed
+ *                fonts in fonttable.h. To add a font include the font file
+ *                and append it to the FONT_LIST, the position in the list is
+ *                the font number used by font_set().
+ *
+ *                A FONT_PACKED font is run length compressed by fontgen and
+ *                only the packed copy is built into the firmware, the font
+ *                file is only included by fontgen. Packed fonts must be
+ *                taller than 8 pixels as they are not proportional.
+ *
+ *  History     :
+ *
+ *****************************************************************************
+ *
+ *  Part of the Serial GLCD firmware, distributed under the MIT license in
+ *  LICENSE.txt.
+ *
+ ****************************************************************************/
+
+#ifndef __FONTS_H
+#define __FONTS_H
+
+#include "font_alt_5x8.h"               /* A updated 5x8 font which is slightly cleaner */
+#include "font_tom_thumb_3x6.h"         /* A small 3x6 font */
+#ifdef FONTGEN
+#include "font_10x16.h"                 /* A large 10x16 numeric font */
+#include "font_7seg_10x16.h"            /* A 10x16 seven segment numeric font */
+#endif
+
+// The fonts in font number order, FONT(name) and FONT_PACKED(name) are
+// defined by the user.
+#define FONT_LIST                               \
+    FONT (font_alt_5x8)                         \
+    FONT (tom_thumb_3x6)                        \
+    FONT_LARGE_LIST
+
+// The large numeric fonts are optional as they need some 600 bytes of
+// flash.
+#if defined(FONT_LARGE) || defined(FONTGEN)
+#define FONT_LARGE_LIST                         \
+    FONT_PACKED (font_10x16)                    \
+    FONT_PACKED (font_7seg_10x16)
+#else
+#define FONT_LARGE_LIST
+#endif
+
+// The number of bytes in the font file header.
+#define FONT_FILE_HEADER_LEN      5
+
+// Flag in the font_space of the header of a packed font. The header of a
+// packed font is followed by a 16-bit offset to each character which is a
+// sequence of runs, a code of 0x00-0x7f is followed by code+1 literal bytes
+// and a code of 0x80-0xff is followed by a byte repeated (code&0x7f)+1 times.
+#define FONT_PACKED_FLAG          0x80
+
+#endif /* __FONTS_H */
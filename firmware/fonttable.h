@@ -0,0 +1,101 @@
+// Generated by fontgen from the fonts in fonts.h, do not edit.
+
+#ifndef __FONTTABLE_H
+#define __FONTTABLE_H
+
+// The proportional widths of font_alt_5x8, first column << 4 | columns.
+static const uint8_t font_alt_5x8_width [96] PROGMEM = {
+    0x05, 0x21, 0x12, 0x05, 0x05, 0x05, 0x05, 0x21,
+    0x13, 0x13, 0x05, 0x05, 0x22, 0x05, 0x22, 0x05,
+    0x05, 0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x22, 0x22, 0x04, 0x05, 0x14, 0x05,
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+    0x05, 0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x05, 0x13, 0x05, 0x13, 0x05, 0x05,
+    0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+    0x05, 0x13, 0x14, 0x04, 0x13, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x05, 0x13, 0x05, 0x13, 0x05, 0x05,
+};
+
+// The proportional widths of tom_thumb_3x6, first column << 4 | columns.
+static const uint8_t tom_thumb_3x6_width [96] PROGMEM = {
+    0x03, 0x11, 0x02, 0x03, 0x03, 0x03, 0x03, 0x11,
+    0x12, 0x02, 0x03, 0x03, 0x02, 0x03, 0x11, 0x03,
+    0x03, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x11, 0x02, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x12, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x11, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x11, 0x03, 0x03, 0x03,
+};
+
+#ifdef FONT_LARGE
+
+// The packed copy of font_10x16, 316 bytes from 545.
+static const char font_10x16_packed [316] PROGMEM = {
+    0x0a, 0x10, 0x82, 0x20, 0x3a, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b,
+    0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b,
+    0x00, 0x3b, 0x00, 0x3d, 0x00, 0x4d, 0x00, 0x56, 0x00, 0x5c, 0x00, 0x62,
+    0x00, 0x73, 0x00, 0x88, 0x00, 0x9a, 0x00, 0xaf, 0x00, 0xc3, 0x00, 0xd5,
+    0x00, 0xe7, 0x00, 0xfb, 0x00, 0x0b, 0x01, 0x1e, 0x01, 0x32, 0x01, 0x93,
+    0x00, 0x00, 0x00, 0x82, 0xc0, 0x01, 0xf8, 0xf8, 0x82, 0xc0, 0x84, 0x00,
+    0x01, 0x07, 0x07, 0x83, 0x00, 0x8b, 0x00, 0x03, 0x80, 0xd8, 0x78, 0x38,
+    0x83, 0x00, 0x00, 0x00, 0x87, 0xc0, 0x8a, 0x00, 0x8c, 0x00, 0x82, 0x38,
+    0x83, 0x00, 0x83, 0x00, 0x0b, 0x80, 0xe0, 0x78, 0x1e, 0x07, 0x01, 0x00,
+    0x20, 0x38, 0x1e, 0x07, 0x01, 0x83, 0x00, 0x13, 0xf8, 0xfe, 0x06, 0x87,
+    0x83, 0x43, 0x67, 0x36, 0xfe, 0xf8, 0x07, 0x1f, 0x1b, 0x39, 0x30, 0x30,
+    0x38, 0x18, 0x1f, 0x07, 0x05, 0x00, 0x0c, 0x0c, 0x06, 0xff, 0xff, 0x84,
+    0x00, 0x82, 0x30, 0x01, 0x3f, 0x3f, 0x82, 0x30, 0x00, 0x00, 0x0f, 0x0c,
+    0x0e, 0x07, 0x03, 0x83, 0xc3, 0xe7, 0x7e, 0x3c, 0x00, 0x38, 0x3c, 0x3e,
+    0x37, 0x33, 0x31, 0x82, 0x30, 0x00, 0x00, 0x02, 0x04, 0x06, 0x07, 0x82,
+    0xc3, 0x06, 0xe7, 0xfe, 0xbc, 0x00, 0x0c, 0x1c, 0x38, 0x83, 0x30, 0x02,
+    0x39, 0x1f, 0x0f, 0x09, 0xc0, 0xe0, 0x30, 0x18, 0x0c, 0x06, 0xff, 0xff,
+    0x00, 0x00, 0x85, 0x03, 0x03, 0x3f, 0x3f, 0x03, 0x03, 0x01, 0x7f, 0x7f,
+    0x84, 0x63, 0x05, 0xe3, 0xc3, 0x80, 0x0c, 0x1c, 0x38, 0x83, 0x30, 0x02,
+    0x38, 0x1f, 0x0f, 0x03, 0xf8, 0xfc, 0xce, 0x67, 0x82, 0x63, 0x05, 0xc3,
+    0xc0, 0x80, 0x0f, 0x1f, 0x38, 0x83, 0x30, 0x02, 0x38, 0x1f, 0x0f, 0x84,
+    0x03, 0x04, 0x83, 0xe3, 0xfb, 0x3f, 0x0f, 0x83, 0x00, 0x02, 0x3e, 0x3f,
+    0x03, 0x82, 0x00, 0x02, 0x1c, 0xbe, 0xf7, 0x83, 0xe3, 0x05, 0xf7, 0xbe,
+    0x1c, 0x0f, 0x1f, 0x39, 0x83, 0x30, 0x02, 0x39, 0x1f, 0x0f, 0x02, 0x7c,
+    0xfe, 0xc7, 0x83, 0x83, 0x05, 0xc7, 0xfe, 0xfc, 0x00, 0x00, 0x30, 0x82,
+    0x31, 0x03, 0x39, 0x1c, 0x0f, 0x07, 0x82, 0x00, 0x82, 0x38, 0x86, 0x00,
+    0x82, 0x0e, 0x83, 0x00,
+};
+
+#endif /* FONT_LARGE */
+
+#ifdef FONT_LARGE
+
+// The packed copy of font_7seg_10x16, 232 bytes from 545.
+static const char font_7seg_10x16_packed [232] PROGMEM = {
+    0x0a, 0x10, 0x82, 0x20, 0x3a, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b,
+    0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b,
+    0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3b, 0x00, 0x3d, 0x00, 0x49, 0x00, 0x3b,
+    0x00, 0x50, 0x00, 0x5f, 0x00, 0x69, 0x00, 0x78, 0x00, 0x87, 0x00, 0x96,
+    0x00, 0xa2, 0x00, 0xb1, 0x00, 0xbe, 0x00, 0xcd, 0x00, 0xdc, 0x00, 0x93,
+    0x00, 0x01, 0x00, 0x00, 0x85, 0x80, 0x83, 0x00, 0x85, 0x01, 0x01, 0x00,
+    0x00, 0x8c, 0x00, 0x01, 0xc0, 0xc0, 0x84, 0x00, 0x01, 0x7c, 0x7c, 0x85,
+    0x03, 0x03, 0x7c, 0x7c, 0x3e, 0x3e, 0x85, 0xc0, 0x01, 0x3e, 0x3e, 0x87,
+    0x00, 0x01, 0x7c, 0x7c, 0x87, 0x00, 0x01, 0x3e, 0x3e, 0x01, 0x00, 0x00,
+    0x85, 0x83, 0x03, 0x7c, 0x7c, 0x3e, 0x3e, 0x85, 0xc1, 0x01, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x85, 0x83, 0x03, 0x7c, 0x7c, 0x00, 0x00, 0x85, 0xc1,
+    0x01, 0x3e, 0x3e, 0x01, 0x7c, 0x7c, 0x85, 0x80, 0x03, 0x7c, 0x7c, 0x00,
+    0x00, 0x85, 0x01, 0x01, 0x3e, 0x3e, 0x01, 0x7c, 0x7c, 0x85, 0x83, 0x83,
+    0x00, 0x85, 0xc1, 0x01, 0x3e, 0x3e, 0x01, 0x7c, 0x7c, 0x85, 0x83, 0x03,
+    0x00, 0x00, 0x3e, 0x3e, 0x85, 0xc1, 0x01, 0x3e, 0x3e, 0x01, 0x00, 0x00,
+    0x85, 0x03, 0x01, 0x7c, 0x7c, 0x87, 0x00, 0x01, 0x3e, 0x3e, 0x01, 0x7c,
+    0x7c, 0x85, 0x83, 0x03, 0x7c, 0x7c, 0x3e, 0x3e, 0x85, 0xc1, 0x01, 0x3e,
+    0x3e, 0x01, 0x7c, 0x7c, 0x85, 0x83, 0x03, 0x7c, 0x7c, 0x00, 0x00, 0x85,
+    0xc1, 0x01, 0x3e, 0x3e, 0x83, 0x00, 0x01, 0x30, 0x30, 0x87, 0x00, 0x01,
+    0x0c, 0x0c, 0x83, 0x00,
+};
+
+#endif /* FONT_LARGE */
+
+#endif /* __FONTTABLE_H */
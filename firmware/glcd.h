@@ -55,6 +55,12 @@
 #define VERSION_MINOR    38             /* The version minor number */
 
 #define SCREEN_MAX_WIDTH  160           /* Maximum width of screen */
+
+// The KS0108B framebuffer build (-DKS0108B_FRAMEBUFFER) needs 1K of RAM for
+// the copy of the 128x64 screen.
+#if defined(KS0108B_FRAMEBUFFER) && (RAMEND <= 0x4ff)
+#error "KS0108B_FRAMEBUFFER requires a device with 2K of RAM (ATmega328P)"
+#endif
 extern uint8_t x_dim;                   /* The width of the screen */
 extern uint8_t y_dim;                   /* The depth of the screen */
 
@@ -119,6 +125,21 @@ do { \
 #define NUM_SPRITES 6
 //#define NUM_SPRITES 1
 
+// VRAM based sprites. On the 160x128 display a sprite identity with
+// VRAM_SPRITE set refers to a sprite held in the spare display memory. The
+// store of the VRAM sprites and the screen slots is only built with
+// -DT6963_STORE.
+#define VRAM_SPRITE        0x40         /* Identity flag of a VRAM sprite */
+#define VRAM_SPRITE_NUM    64           /* Number of VRAM sprites. */
+
+// Screen save slots. On the 160x128 display areas of the screen may be saved
+// to the spare display memory and restored.
+#define SCREEN_SLOT_NUM    4            /* Number of screen save slots. */
+
+// Text windows. Each window has its own rectangle, cursor, font and mode.
+// The windows are only built with -DFONT_WINDOW.
+#define FONT_WINDOW_NUM    4            /* Number of text windows. */
+
 //////////////////////////////////////////////////////////////////////////////
 // Constants
 // 0 - Version major
@@ -213,6 +234,9 @@ extern uint8_t prefs [PREFS_ADDR_MAX];
 #define MODE_LINE_SKIP_LAST   0x80      /* Skip the last pixel on line */
 #define MODE_LINE_MASK        (MODE_LINE_SKIP_LAST)
 
+// Largest integer scale of bitblt, sprites and fonts, see draw_scale().
+#define SCALE_MAX             4
+
 /* Validate the coordinates */
 #define x_valid(x)   (((x) >= 0) && ((x) < x_dim))
 #define y_valid(y)   (((y) & ~(y_dim - 1)) == 0)
@@ -353,6 +377,17 @@ serial_flush (void);
 uint8_t
 serial_flushc (uint8_t bytes);
 
+//////////////////////////////////////////////////////////////////////////////
+///
+/// Get the number of characters that may be read from the RX_buffer without
+/// blocking. No characters are reported while a display list is being
+/// replayed.
+///
+/// @return The number of characters that have been received.
+///
+extern uint8_t
+serial_ready (void);
+
 //////////////////////////////////////////////////////////////////////////////
 ///
 /// Peek into the RX_buffer and retrieve a character from the RX_buffer before
@@ -434,7 +469,7 @@ extern void
 ks0108b_screen_clear (uint8_t mode);
 
 /////////////////////////////////////////////////////////////////////////////
-/// Scroll the display up by 1 line.
+/// Scroll the display vertically using the display start line.
 ///
 /// @param [in] buf The buffer to use for reading and writing
 /// @param [in] pixels The number of pixels to scroll where -ve is up
@@ -443,6 +478,36 @@ ks0108b_screen_clear (uint8_t mode);
 extern void
 ks0108b_vscroll (uint8_t *buf, int8_t pixels, uint8_t mode);
 
+/////////////////////////////////////////////////////////////////////////////
+/// Scroll a window of the display up by copying its rows, the lines that
+/// scroll into the bottom of the window are cleared.
+///
+/// @param [in] x0 The left x-coordinate of the window.
+/// @param [in] y0 The top y-coordinate of the window.
+/// @param [in] x1 The right x-coordinate of the window.
+/// @param [in] y1 The bottom y-coordinate of the window.
+/// @param [in] pixels The number of pixels to scroll up.
+/// @param [in] mode The current mode.
+///
+extern void
+ks0108b_wscroll (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t pixels, uint8_t mode);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Copy a rectangle of the display to another position, the rectangles may
+/// overlap. The rectangles are on the screen.
+///
+/// @param [in] sx The left x-coordinate of the source.
+/// @param [in] sy The top y-coordinate of the source.
+/// @param [in] width The width of the rectangle in pixels.
+/// @param [in] height The height of the rectangle in pixels.
+/// @param [in] dx The left x-coordinate of the destination.
+/// @param [in] dy The top y-coordinate of the destination.
+/// @param [in] mode The merging mode of the copy.
+///
+extern void
+ks0108b_copy_rect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                    uint8_t dx, uint8_t dy, uint8_t mode);
+
 /////////////////////////////////////////////////////////////////////////////
 /// Reverse the display. We read all of the screen values, invert them and
 /// then write them back.
@@ -535,6 +600,19 @@ ks0108b_set_pixel (uint8_t x, uint8_t y, uint8_t mode);
 extern void
 ks0108b_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode, uint8_t *data);
 
+//////////////////////////////////////////////////////////////////////////////
+/// Horizontal bitblt of row organised data, most significant bit on the
+/// left. Each band of 8 rows is transposed and drawn with ks0108b_vbitblt().
+///
+/// @param [in] x,y is upper left corner of image in pixels.
+/// @param [in] width The width of the image in pixels.
+/// @param [in] height The height of the image in pixels.
+/// @param [in] mode The drawing mode, MODE_FILL is not supported.
+/// @param [in] data The row data or NULL for serial.
+///
+extern void
+ks0108b_hbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode, uint8_t *data);
+
 /////////////////////////////////////////////////////////////////////////////
 /// Draw a horizontal line
 ///
@@ -557,6 +635,14 @@ ks0108b_hline (uint8_t x, uint8_t y, uint8_t x1, uint8_t mode);
 extern void
 ks0108b_vline (uint8_t x, uint8_t y, uint8_t y1, uint8_t mode);
 
+/////////////////////////////////////////////////////////////////////////////
+/// Write the changed columns of the framebuffer or the page cache to the
+/// display. Does nothing when there are no changes or when the driver is
+/// built without either.
+///
+extern void
+ks0108b_flush (void);
+
 /***************************************************************************
  * Drawing                                                                 *
  * Base level drawing operations                                           *
@@ -579,7 +665,7 @@ extern void
 t6963_screen_clear (uint8_t mode);
 
 /////////////////////////////////////////////////////////////////////////////
-/// Scroll the display up by 1 character line.
+/// Scroll the display vertically by moving the graphic home address.
 ///
 /// @param [in] buf The buffer to use for reading and writing
 /// @param [in] pixels The number of pixels to scroll where -ve is up
@@ -588,6 +674,36 @@ t6963_screen_clear (uint8_t mode);
 extern void
 t6963_vscroll (uint8_t *buf, int8_t pixels, uint8_t mode);
 
+/////////////////////////////////////////////////////////////////////////////
+/// Scroll a window of the display up by copying its rows, the lines that
+/// scroll into the bottom of the window are cleared.
+///
+/// @param [in] x0 The left x-coordinate of the window.
+/// @param [in] y0 The top y-coordinate of the window.
+/// @param [in] x1 The right x-coordinate of the window.
+/// @param [in] y1 The bottom y-coordinate of the window.
+/// @param [in] pixels The number of pixels to scroll up.
+/// @param [in] mode The current mode.
+///
+extern void
+t6963_wscroll (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t pixels, uint8_t mode);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Copy a rectangle of the display to another position, the rectangles may
+/// overlap. The rectangles are on the screen.
+///
+/// @param [in] sx The left x-coordinate of the source.
+/// @param [in] sy The top y-coordinate of the source.
+/// @param [in] width The width of the rectangle in pixels.
+/// @param [in] height The height of the rectangle in pixels.
+/// @param [in] dx The left x-coordinate of the destination.
+/// @param [in] dy The top y-coordinate of the destination.
+/// @param [in] mode The merging mode of the copy.
+///
+extern void
+t6963_copy_rect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                  uint8_t dx, uint8_t dy, uint8_t mode);
+
 /////////////////////////////////////////////////////////////////////////////
 /// Reverse the display. We read all of the screen values, invert them and
 /// then write them back.
@@ -597,6 +713,112 @@ t6963_vscroll (uint8_t *buf, int8_t pixels, uint8_t mode);
 extern void
 t6963_screen_reverse (uint8_t *buf);
 
+// Page flip flags.
+#define PAGE_FLIP_COPY          0x01    /* Copy the new front page to the back */
+
+/////////////////////////////////////////////////////////////////////////////
+/// Enable or disable page mode. In page mode drawing is performed on a back
+/// page that is not displayed until the pages are flipped.
+///
+/// @param [in] enable Non-zero to enable page mode.
+///
+extern void
+t6963_page_mode (uint8_t enable);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Flip the pages in page mode.
+///
+/// @param [in] flags PAGE_FLIP_COPY to copy the displayed page to the back
+///                   page after the flip.
+///
+extern void
+t6963_page_flip (uint8_t flags);
+
+#ifdef T6963_STORE
+/////////////////////////////////////////////////////////////////////////////
+/// Draws a VRAM sprite at (x,y) using mode.
+///
+/// @param [in] x is the first x-coordinate to start drawing.
+/// @param [in] y is the first y-coordinate to start drawing.
+/// @param [in] sprite_id identifies the sprite to draw 0..VRAM_SPRITE_NUM-1.
+/// @param [in] mode The drawing mode.
+///
+extern void
+t6963_sprite_draw (uint8_t x, uint8_t y, uint8_t sprite_id, uint8_t mode);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Upload a VRAM sprite. The sprite data is collected from serial in the
+/// native bitblt format. A sprite with no width or height is deleted.
+///
+/// @param [in] sprite_id The identity of the sprite 0..VRAM_SPRITE_NUM-1.
+/// @param [in] width The width of the sprite in bits.
+/// @param [in] height The height of the sprite in bits.
+///
+extern void
+t6963_sprite_upload (uint8_t sprite_id, uint8_t width, uint8_t height);
+
+// Screen restore flags.
+#define SCREEN_RESTORE_RELEASE  0x01    /* Release the slot after the restore */
+
+/////////////////////////////////////////////////////////////////////////////
+/// Save a rectangle of the screen to a slot in display memory.
+///
+/// @param [in] slot The slot to save to 0..SCREEN_SLOT_NUM-1.
+/// @param [in] x1 The left x-coordinate.
+/// @param [in] y1 The top y-coordinate.
+/// @param [in] x2 The right x-coordinate.
+/// @param [in] y2 The bottom y-coordinate.
+///
+extern void
+t6963_screen_save (uint8_t slot, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Restore a saved rectangle of the screen to the place it was saved from.
+///
+/// @param [in] slot The slot to restore from 0..SCREEN_SLOT_NUM-1.
+/// @param [in] flags SCREEN_RESTORE_RELEASE to release the slot.
+///
+extern void
+t6963_screen_restore (uint8_t slot, uint8_t flags);
+#endif /* T6963_STORE */
+
+#ifdef T6963_TEXT_LAYER
+// Text layer flags.
+#define TEXT_LAYER_ON           0x01    /* Enable the text layer */
+#define TEXT_LAYER_ATTRIBUTE    0x02    /* Attribute mode, hides the graphics */
+#define TEXT_LAYER_BLINK        0x04    /* New characters blink (attribute mode) */
+
+/////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the hardware text layer.
+///
+/// @param [in] flags TEXT_LAYER_ON with options to enable, zero to disable.
+///
+/// @return The flags in effect, zero if the text layer is off.
+///
+extern uint8_t
+t6963_text_layer (uint8_t flags);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Load a character into the CG RAM of the text layer.
+///
+/// @param [in] code The character code 0..95, the character less 0x20.
+/// @param [in] buf The 8 columns of the character in bitblt format.
+///
+extern void
+t6963_text_glyph (uint8_t code, uint8_t *buf);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a character on the text layer in the 8x8 cell that contains x,y.
+///
+/// @param [in] x The x-coordinate of the character.
+/// @param [in] y The y-coordinate of the character.
+/// @param [in] code The character code 0..95, the character less 0x20.
+/// @param [in] mode The drawing mode.
+///
+extern void
+t6963_text_draw (uint8_t x, uint8_t y, uint8_t code, uint8_t mode);
+#endif /* T6963_TEXT_LAYER */
+
 /////////////////////////////////////////////////////////////////////////////
 /// Set a single pixel. Set assumes that the pixel is being set. This is
 /// important as the mode flag set to '0' means reverse which is clear a
@@ -807,6 +1029,19 @@ t6963_set_row (uint8_t x_column, uint8_t y, uint8_t data, uint8_t mask, uint8_t
 extern void
 t6963_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode, uint8_t* data);
 
+//////////////////////////////////////////////////////////////////////////////
+/// Horizontal bitblt of row organised data, most significant bit on the
+/// left. This matches the display memory so rows are written directly.
+///
+/// @param [in] x,y is upper left corner of image in pixels.
+/// @param [in] width The width of the image in pixels.
+/// @param [in] height The height of the image in pixels.
+/// @param [in] mode The drawing mode, MODE_FILL is not supported.
+/// @param [in] data The row data or NULL for serial.
+///
+extern void
+t6963_hbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode, uint8_t* data);
+
 /////////////////////////////////////////////////////////////////////////////
 /// Draw a horizontal line
 ///
@@ -888,10 +1123,24 @@ lcd_screen_clear (void);
 #define lcd_vbitblt(x, y, width, height, mode, data)  \
 ((vfunc_iiiiip_t)(pgm_read_word(&functabP[(uint8_t)F_DRV_VBITBLT])))(x, y, width, height, mode, data)
 
+// Horizontal bitblt
+#define lcd_hbitblt(x, y, width, height, mode, data)  \
+((vfunc_iiiiip_t)(pgm_read_word(&functabP[(uint8_t)F_DRV_HBITBLT])))(x, y, width, height, mode, data)
+
 // Vertical scroll
 #define lcd_vscroll(buf, pixels, mode) \
 ((vfunc_psi_t)(pgm_read_word(&functabP[(uint8_t)F_DRV_VSCROLL])))(buf, pixels, mode)
 
+#ifdef FONT_WINDOW
+// Window scroll
+#define lcd_wscroll(x0, y0, x1, y1, pixels, mode) \
+((vfunc_iiiiii_t)(pgm_read_word(&functabP[(uint8_t)F_DRV_WSCROLL])))(x0, y0, x1, y1, pixels, mode)
+#endif
+
+// Rectangle copy
+#define lcd_copy_rect(sx, sy, width, height, dx, dy, mode) \
+((vfunc_iiiiiii_t)(pgm_read_word(&functabP[(uint8_t)F_DRV_COPY_RECT])))(sx, sy, width, height, dx, dy, mode)
+
 //////////////////////////////////////////////////////////////////////////////
 /// Hard reset the screen.
 ///
@@ -925,12 +1174,10 @@ graphics_mode (uint8_t cmd);
  * Graphics commands                                                       *
  ***************************************************************************/
 
-// Buffer used for line blitting; this is 8 pairs of coordinates. The line
-// buffer is also used for expanding the fonts redy for rendering.
+// Buffer used for line blitting; this is 8 pairs of coordinates.
 #define LINE_BUFFER_MAX   16
 
 uint8_t line_buffer [LINE_BUFFER_MAX];
-#define font_buffer line_buffer
 
 // Buffer used for bitblt and other draw operations.
 extern uint8_t draw_buffer [SCREEN_MAX_WIDTH];
@@ -938,6 +1185,14 @@ extern uint8_t draw_buffer [SCREEN_MAX_WIDTH];
 // The current draw mode.
 extern uint8_t drawing_mode;
 
+#ifdef DRAW_SCALE
+// The integer scale of bitblts, sprites and fonts.
+extern uint8_t drawing_scale;
+#else
+// Without DRAW_SCALE everything is drawn unscaled.
+#define drawing_scale 1
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 /// Change the current draw mode
 ///
@@ -946,6 +1201,67 @@ extern uint8_t drawing_mode;
 extern void
 draw_mode (uint8_t mode);
 
+#ifdef DRAW_SCALE
+//////////////////////////////////////////////////////////////////////////
+/// Change the integer scale of the bitblts, sprites and fonts.
+///
+/// @param [in] scale The new scale 1..SCALE_MAX.
+///
+extern void
+draw_scale (uint8_t scale);
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+/// Set the clip rectangle of the drawing. The rectangle is in screen
+/// coordinates and is limited to the screen.
+///
+/// @param [in] x0 The left column.
+/// @param [in] y0 The top row.
+/// @param [in] x1 The right column.
+/// @param [in] y1 The bottom row.
+///
+extern void
+draw_clip (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+
+//////////////////////////////////////////////////////////////////////////
+/// Set the origin that is added to the coordinates of the graphics
+/// commands.
+///
+/// @param [in] x The column of the origin.
+/// @param [in] y The row of the origin.
+///
+extern void
+draw_origin (uint8_t x, uint8_t y);
+
+//////////////////////////////////////////////////////////////////////////
+/// Move a point by the origin for the drawing that the driver performs
+/// directly, such as a VRAM sprite, which is not clipped.
+///
+/// @param [in,out] x The column of the point.
+/// @param [in,out] y The row of the point.
+///
+/// @return Non-zero if the moved point is within the coordinate range.
+///
+extern uint8_t
+draw_at_origin (uint8_t *x, uint8_t *y);
+
+//////////////////////////////////////////////////////////////////////////
+/// Copy a rectangle of the screen to another position. The coordinates
+/// are moved by the origin and the destination is clipped to the clip
+/// rectangle, the rectangles may overlap.
+///
+/// @param [in] sx The left x-coordinate of the source.
+/// @param [in] sy The top y-coordinate of the source.
+/// @param [in] width The width of the rectangle in pixels.
+/// @param [in] height The height of the rectangle in pixels.
+/// @param [in] dx The left x-coordinate of the destination.
+/// @param [in] dy The top y-coordinate of the destination.
+/// @param [in] s_r The drawing mode of the copy.
+///
+extern void
+draw_copy_rect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                uint8_t dx, uint8_t dy, uint8_t s_r);
+
 //////////////////////////////////////////////////////////////////////////////
 /// Draws a box. The box is described by a diagonal line from x, y1 to x2, y2.
 ///
@@ -1050,7 +1366,9 @@ draw_lines (uint8_t x, uint8_t y, uint8_t s_r, uint8_t *data);
 /// @param [in] data A pointer to a list of (x,y) coordinate pairs. The
 ///                  end of the list is terminated with y|0x80. A value of
 ///                  NULL then the coordinate list is read from the serial
-///                  input.
+///                  input. A MODE_FILL polygon may have at most
+///                  POLYGON_MAX (32) vertices, a fill with more vertices
+///                  is read and discarded.
 ///
 extern void
 draw_polygon (uint8_t x, uint8_t y, uint8_t s_r, uint8_t *data);
@@ -1127,9 +1445,40 @@ fill_vbox (uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t data);
 ///
 ///             0x10 - MODE_FILL
 ///                    Interpret the data as a mask and fill.
+///
+/// The bitmap is drawn at the scale set with draw_scale().
 extern void
 draw_vbitblt (uint8_t x, uint8_t y, uint8_t mode, uint8_t *data);
 
+//////////////////////////////////////////////////////////////////////////////
+/// Vertical bitblt of a bitmap at an integer scale. Each bit of the data is
+/// expanded to a scale x scale square as the bitmap is drawn. The bitmap is
+/// clipped to the clip rectangle but is not moved by the origin.
+///
+/// @param [in] x,y is upper left corner of image on the screen.
+/// @param [in] width,height The size of the data in pixels.
+/// @param [in] mode The resolved driver mode, see lcd_vbitblt().
+/// @param [in] scale The scale 1..4.
+/// @param [in] data The data or NULL for serial.
+///
+extern void
+draw_scaled_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                     uint8_t mode, uint8_t scale, uint8_t *data);
+
+//////////////////////////////////////////////////////////////////////////////
+/// Horizontal bitblt does a bit transfer of row organised data to display
+/// memory. Each row is (width + 7) / 8 bytes with the most significant bit
+/// on the left. If NULL is passed as data, bitblt takes the width, height
+/// and data from the serial port.
+///
+/// @param [in] x,y is upper left corner of image in pixels.
+/// @param [in] mode The drawing mode, see draw_vbitblt(). MODE_FILL is
+///             ignored.
+/// @param [in] data The width, height and row data or NULL for serial.
+///
+extern void
+draw_hbitblt (uint8_t x, uint8_t y, uint8_t mode, uint8_t *data);
+
 /***************************************************************************
  * Font Handling                                                           *
  ***************************************************************************/
@@ -1150,9 +1499,9 @@ draw_vbitblt (uint8_t x, uint8_t y, uint8_t mode, uint8_t *data);
 /// Initialise the fonts.
 /// We install the fonts that we are using.
 ///
-/// @param [in] fptr Pointer to the font file in flash memory.
+/// @param [in] font The font number, see font_set().
 extern void
-font_init (const char *fptr);
+font_init (uint8_t font);
 
 //////////////////////////////////////////////////////////////////////////////
 /// Changes the current font
@@ -1176,6 +1525,16 @@ font_set (uint8_t font, uint8_t cmd);
 extern void
 font_draw (char txt);
 
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a character received from the serial input followed by the run of
+/// printable characters that have already been received, these are drawn
+/// with a single bitblt.
+///
+/// @param [in] txt The character to draw.
+///
+extern void
+font_draw_run (char txt);
+
 /////////////////////////////////////////////////////////////////////////////
 /// Draw a string on screen
 ///
@@ -1251,6 +1610,56 @@ font_lf (void);
 extern void
 font_mode (uint8_t mode);
 
+//////////////////////////////////////////////////////////////////////////////
+/// Compute the size of the character cell on the screen, called when the
+/// drawing scale changes.
+///
+extern void
+font_cell (void);
+
+#ifdef T6963_TEXT_LAYER
+//////////////////////////////////////////////////////////////////////////////
+/// Enable or disable console output on the hardware text layer of the
+/// 160x128 display. Characters are drawn in 8x8 cells with the default font.
+///
+/// @param [in] flags TEXT_LAYER_ON with options to enable, zero to disable.
+extern void
+font_text_layer (uint8_t flags);
+#endif
+
+// Text window flags.
+#define FONT_WINDOW_SCROLL      0x01    /* Scroll, otherwise wrap to the top */
+#define FONT_WINDOW_WRAP        0x02    /* Wrap, otherwise discard long lines */
+
+//////////////////////////////////////////////////////////////////////////////
+/// Initialise the text windows to the whole screen and select window 0.
+///
+extern void
+font_window_init (void);
+
+#ifdef FONT_WINDOW
+//////////////////////////////////////////////////////////////////////////////
+/// Define a text window with the current font and mode, the cursor is moved
+/// to the top left of the window.
+///
+/// @param [in] id The window 0..FONT_WINDOW_NUM-1.
+/// @param [in] x0 The left x-coordinate.
+/// @param [in] y0 The top y-coordinate.
+/// @param [in] x1 The right x-coordinate.
+/// @param [in] y1 The bottom y-coordinate.
+/// @param [in] flags FONT_WINDOW_SCROLL and FONT_WINDOW_WRAP.
+extern void
+font_window_define (uint8_t id, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t flags);
+
+//////////////////////////////////////////////////////////////////////////////
+/// Select the text window that characters are drawn in. Each window keeps
+/// its own cursor, font and mode.
+///
+/// @param [in] id The window 0..FONT_WINDOW_NUM-1.
+extern void
+font_window_select (uint8_t id);
+#endif /* FONT_WINDOW */
+
 /***************************************************************************
  * Sprite Handling                                                         *
  ***************************************************************************/
@@ -1286,4 +1695,137 @@ sprite_upload (uint8_t sprite_id, uint8_t width, uint8_t height);
 extern void
 sprite_splash (void);
 
+/***************************************************************************
+ * Display Lists                                                           *
+ ***************************************************************************/
+
+// The display lists are only built with -DDISPLAY_LIST.
+#ifdef DISPLAY_LIST
+
+// RAM allocated to the display list store. The ATmega168 only has 1K for
+// all variables so the store is kept small on that device. The KS0108B
+// framebuffer build uses 1K of the ATmega328P RAM for the screen copy so
+// the store is also kept small there.
+#if (RAMEND > 0x4ff) && !defined(KS0108B_FRAMEBUFFER)
+#define LIST_STORE_SIZE          512
+#else
+#define LIST_STORE_SIZE           64
+#endif
+
+// The maximum nesting of display list calls.
+#define LIST_DEPTH                 4
+
+// EEPROM based display lists are identified by the top bit of the list
+// identity in the same way as sprites. The EEPROM of the ATmega168 is
+// used by the sprites so these are only available on larger devices.
+#define LIST_EEPROM             0x80
+#if E2END > 0x1ff
+#define EEPROM_ADDR_LIST_START   512    /* Start address of EEPROM list memory. */
+#define EEPROM_LIST_SIZE          64    /* Size of a list including the length */
+#define EEPROM_LIST_NUM          ((E2END + 1 - EEPROM_ADDR_LIST_START) / EEPROM_LIST_SIZE)
+#else
+#define EEPROM_LIST_NUM            0    /* No EEPROM lists */
+#endif
+
+// Display list templates. An escape byte in a list is followed by the
+// number of the argument to substitute, two escapes are a literal escape.
+#define LIST_ARGS                  8    /* Number of template arguments */
+#define LIST_ESCAPE             0xff    /* Argument escape byte */
+
+// The recording states.
+#define LIST_RECORD_OFF            0    /* Not recording */
+#define LIST_RECORD_ON             1    /* Recording a list */
+#define LIST_RECORD_OVERFLOW       2    /* List is too big, will be discarded */
+
+// The display list recording state.
+extern uint8_t list_recording;
+
+// The number of display lists that are being replayed.
+extern uint8_t list_depth;
+
+/////////////////////////////////////////////////////////////////////////////
+/// Start recording a display list. The commands that follow are executed
+/// as normal and are also captured into the list until CMDX_LIST_END.
+///
+/// @param [in] id The identity of the list. An existing list with the same
+///                identity is replaced.
+///
+extern void
+list_begin (uint8_t id);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Finish recording a display list.
+///
+extern void
+list_end (void);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Replay a display list through the command interpreter.
+///
+/// @param [in] id The identity of the list.
+///
+extern void
+list_call (uint8_t id);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Define a display list from the bytes that follow on the serial port
+/// without executing it.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] length The number of bytes in the list.
+///
+extern void
+list_define (uint8_t id, uint8_t length);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Replay a display list template with the arguments that follow on the
+/// serial port.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] argc The number of arguments.
+///
+extern void
+list_exec (uint8_t id, uint8_t argc);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Replay a display list template a number of times with the arguments
+/// and the steps that follow on the serial port.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] count The number of times to replay the list.
+/// @param [in] argc The number of arguments and the number of steps.
+///
+extern void
+list_repeat (uint8_t id, uint8_t count, uint8_t argc);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Record a byte received from the serial port into the current list.
+///
+/// @param [in] cc The byte to record.
+///
+extern void
+list_record (uint8_t cc);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Get the next byte from the display list that is being replayed.
+///
+/// @return The next byte of the list.
+///
+extern uint8_t
+list_getc (void);
+
+/////////////////////////////////////////////////////////////////////////////
+/// Peek ahead into the display lists that are being replayed.
+///
+/// @param [in,out] offset The offset from the read position. Adjusted to be
+///                        an offset into the serial buffer when the offset
+///                        is beyond the end of the lists.
+///
+/// @return The byte at the offset or -1 when beyond the end of the lists.
+///
+extern int16_t
+list_peek (uint16_t *offset);
+
+#endif /* DISPLAY_LIST */
+
 #endif /* __GLCD_H */
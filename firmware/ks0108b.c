@@ -85,6 +85,55 @@
  * modified in any way then it is advised that a lot of testing is required
  * using both sides of the screen to ensure that no regresions are
  * introduced.
+ *
+ * Vertical scrolling uses the display start line register. The start line
+ * is the RAM line that is displayed at the top of the screen so the screen
+ * is scrolled by changing the start line and clearing the band of lines
+ * that wraps around onto the screen. All drawing is performed in screen
+ * coordinates and mapped to RAM in set_y_position(). When the start line is
+ * a multiple of 8 then a screen row maps directly onto a RAM page. When it
+ * is not then a screen row straddles two RAM pages and the row is written
+ * as two masked halves; this is slower than the aligned case but only
+ * happens after an unaligned scroll. A screen clear resets the start line.
+ *
+ * When built with KS0108B_FRAMEBUFFER (ATmega328P only) the driver keeps a
+ * copy of the display RAM in frame[]. The block and column read/write
+ * methods then work on the copy and only record the range of columns that
+ * changed in each page, so drawing, merging, XOR and screen reverse never
+ * read the LCD. ks0108b_flush() writes the changed columns to the display
+ * and is called by serial_getc() whenever it waits for input. The start
+ * line register is still used for scrolling, the copy is organised by RAM
+ * page so only the band that wraps onto the screen is cleared.
+ *
+ * Without the framebuffer there is not enough RAM on the ATmega168 for a
+ * copy of the display. When built with KS0108B_CACHE the driver caches the
+ * columns of a single RAM page of one chip in cache[]. A read of a column
+ * the cache already holds, or a merge of a column, is performed in the
+ * cache and the changed columns are written back as one run when a
+ * different page or chip is accessed or when ks0108b_flush() is called.
+ * Successive columns of text, lines and bitblt operations in the same row
+ * then cost a single read and write of the run rather than a read,
+ * re-address and write of every column. Otherwise each block and column is
+ * read from and written to the display as it is drawn.
+ *
+ * The cache and its state take 69 bytes of RAM, which is why it is not
+ * built by default on the ATmega168. It can not share the draw_buffer as
+ * the callers build the data that is written through the cache in the
+ * draw_buffer while the cache holds changed columns.
+ *
+ * The two chips each have their own column address and busy flag. A run of
+ * a page that crosses both chips, a framebuffer flush or a whole row written
+ * without the framebuffer, alternates the writes between the chips so that
+ * the busy time of one chip is spent writing the other and only the chip
+ * about to be written is polled.
+ *
+ * When built with KS0108B_TIMED_BURST=<ns> the runs of data written to a
+ * page, by the cache or framebuffer write back and the screen clear, do not
+ * read the busy flag between bytes. The first byte of a run is written with
+ * a status check and each following byte waits the given busy time with a
+ * cycle counted delay. The busy time depends on the controller clock of
+ * the panel so it has to be calibrated against the panel in use, if
+ * columns go missing then the value is too small.
  ***************************************************************************/
 
 /****************************************************************************
@@ -155,6 +204,8 @@
 #define CMD_READ         (CMD_RS | CMD_RW | CMD_RES)
 /* Data write */
 #define CMD_WRITE        (CMD_RS | CMD_RES)
+/* Set the display start line */
+#define CMD_START_LINE   (0x00c0 | CMD_RES)
 
 // Define the dimensions of the screen
 #define SCREEN_WIDTH 128                /* Screen width */
@@ -167,7 +218,33 @@
 #define SCREEN_HEIGHT_MASK (SCREEN_HEIGHT-1)
 #define SCREEN_ROWS_MASK   0x07
 
+// The number of columns of a split row that are processed at a time.
+#define SPLIT_CHUNK        16
+
 static uint8_t y_row;                   /* The current y row position */
+static uint8_t y_start;                 /* The display start line */
+
+#ifdef KS0108B_FRAMEBUFFER
+static uint8_t frame [SCREEN_ROWS][SCREEN_WIDTH]; /* Copy of the display RAM */
+static uint8_t dirty_first [SCREEN_ROWS]; /* First changed column of a page */
+static uint8_t dirty_end [SCREEN_ROWS];   /* Past the last changed column, 0 clean */
+#else
+// A chip page is tagged with the RAM page and CACHE_CHIP2 set for the right
+// hand chip.
+#define CACHE_CHIP2        0x08         /* Tag flag of the right hand chip */
+
+#ifdef KS0108B_CACHE
+// The page cache holds the columns of one RAM page of one chip.
+#define CACHE_GAP          8            /* Largest gap joined in the cache */
+
+static uint8_t cache [SCREEN_PAGE];     /* The cached columns */
+static uint8_t cache_tag;               /* The page and chip cached */
+static uint8_t cache_first;             /* The first valid column */
+static uint8_t cache_end;               /* Past the last valid column, 0 empty */
+static uint8_t cache_dirty_first;       /* The first changed column */
+static uint8_t cache_dirty_end;         /* Past the last changed column, 0 clean */
+#endif
+#endif
 
 static __inline__ uint8_t
 merge_column (uint8_t new_column, uint8_t orig_column, uint8_t mode)
@@ -177,8 +254,8 @@ merge_column (uint8_t new_column, uint8_t orig_column, uint8_t mode)
 
     if (mode >= MODE_XOR)
     {
-        // This is XOR or NAND */
-        if ((mode & MODE_XOR) != 0)
+        // This is XOR or NAND, NAND has both the OR and XOR bits set.
+        if (mode == MODE_XOR)
         {
             // MODE_XOR - XOR the existing buffer data with read data.
             new_column ^= orig_column;
@@ -199,6 +276,73 @@ merge_column (uint8_t new_column, uint8_t orig_column, uint8_t mode)
     return new_column;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Merge a row of data with the screen data. This is merge_column() and the
+/// mask merge of a row with the reverse and the operation resolved once for
+/// the row, each operation has its own loop that reduces the merge of the
+/// data under the mask to a single operation per column.
+///
+/// @param [in] screen The screen data.
+/// @param [in,out] buf The data, replaced by the merged data.
+/// @param [in] length The number of columns, non-zero.
+/// @param [in] mask The data mask.
+/// @param [in] mode The merge operation to perform.
+///
+static void
+merge_block (uint8_t *screen, uint8_t *buf, uint8_t length, uint8_t mask, uint8_t mode)
+{
+    uint8_t reverse;                    // Inverts the screen data
+
+    // Apply any reverse setting; if the reverse bit is set then we negate
+    // the screen data.
+    reverse = 0;
+    if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
+        reverse = 0xff;
+
+    switch (mode & MODE_OP_MASK)
+    {
+    case MODE_OR:
+        // Set the bits of the data under the mask.
+        do
+        {
+            *buf = (*buf & mask) | (*screen++ ^ reverse);
+            buf++;
+        }
+        while (--length > 0);
+        break;
+    case MODE_XOR:
+        // Toggle the bits of the data under the mask.
+        do
+        {
+            *buf = (*buf & mask) ^ (*screen++ ^ reverse);
+            buf++;
+        }
+        while (--length > 0);
+        break;
+    case MODE_NAND:
+        // Clear the bits of the data under the mask.
+        do
+        {
+            *buf = ~(*buf & mask) & (*screen++ ^ reverse);
+            buf++;
+        }
+        while (--length > 0);
+        break;
+    default:
+        // MODE_MERGE - Copy the data under the mask, a full mask leaves the
+        // data unchanged.
+        if (mask == 0xff)
+            break;
+        do
+        {
+            *buf = (*buf & mask) | ((*screen++ ^ reverse) & ~mask);
+            buf++;
+        }
+        while (--length > 0);
+        break;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// Perform status check to make sure that the controller is ready.
 /// controller. The status_check is performed for the last command that
@@ -272,27 +416,17 @@ status_check (uint8_t portc_next)
 }
 
 /////////////////////////////////////////////////////////////////////////////
-/// Write a command to the controller. Note that "reading" a command is
-/// nonsensical and no cmd_read() function is provided.
+/// Strobe a byte onto the bus. The controller must be ready.
 ///
-/// @param [in] command The command to write.
-///                     The lower 8-bits contain the command.
-///                     The upper 8-bits contain next status to be read.
+/// @param [in] portc The control lines.
+/// @param [in] data The byte to write.
 ///
-static void
-ks0108b_write (uint16_t data)
+static __inline__ void
+bus_write (uint8_t portc, uint8_t data)
 {
-    uint8_t portc;                      // New portc setting
     uint8_t portc_en;                   // New portc setting with EN
     uint8_t ddrb;                       // Temporary of port B control
 
-    // Prepare the portc ready for testing when the status check completes.
-    portc = data >> 8;                  // Get the port data
-
-    // Ensure the chip is ready for the operation. Send the new portc setting
-    // so that the new chip select may be checked for readyness.
-    status_check (portc);
-
     // Prepare the control lines.
     PORTC = portc;
 
@@ -323,6 +457,55 @@ ks0108b_write (uint16_t data)
     DDRB &= ~0x03;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Write a command to the controller. Note that "reading" a command is
+/// nonsensical and no cmd_read() function is provided.
+///
+/// @param [in] command The command to write.
+///                     The lower 8-bits contain the command.
+///                     The upper 8-bits contain next status to be read.
+///
+static void
+ks0108b_write (uint16_t data)
+{
+    uint8_t portc;                      // New portc setting
+
+    // Prepare the portc ready for testing when the status check completes.
+    portc = data >> 8;                  // Get the port data
+
+    // Ensure the chip is ready for the operation. Send the new portc setting
+    // so that the new chip select may be checked for readyness.
+    status_check (portc);
+
+    // Write the data.
+    bus_write (portc, data);
+}
+
+#ifdef KS0108B_TIMED_BURST
+/////////////////////////////////////////////////////////////////////////////
+/// Write the next data byte of a burst. The last transfer to the chips must
+/// be a data write, either the previous transfer or the one before it when
+/// the two chips are interleaved. The busy time of that write is waited out
+/// with a cycle counted delay rather than reading the status so the data
+/// bus is not turned around for every byte. Commands and the first write
+/// after a command must use ks0108b_write() which checks the status.
+///
+/// @param [in] command The CMD_WRITE command with the data.
+///
+static void
+ks0108b_burst (uint16_t data)
+{
+    // Wait out the busy time of the previous write.
+    _delay_us (KS0108B_TIMED_BURST / 1000.0);
+
+    // Write the data.
+    bus_write (data >> 8, data);
+}
+#else
+// Every write checks the status.
+#define ks0108b_burst(data)     ks0108b_write (data)
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 /// Read a byte of data from the screen
 ///
@@ -368,40 +551,375 @@ ks0108b_read (uint16_t command)
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// Set the y column. This function caches the current y row position and
-/// instructs the display to modify the row position when the cached version
-/// does not match the new row. This prevents display commands being
-/// dispatched for continual position changes on the same line that affect x
-/// bit not y.
+/// Select a RAM page. This function caches the current page and instructs
+/// the display to modify the row position when the cached version does not
+/// match the new page. This prevents display commands being dispatched for
+/// continual position changes on the same line that affect x bit not y.
 ///
-/// @param [in] y The new y position required.
+/// @param [in] page The RAM page required.
 ///
 static void
-set_y_position (uint8_t y)
+set_page (uint8_t page)
 {
-    // Ensure y is in the correct range.
-    y &= 0x7;
-
     // If the row is already selected then skip the position command.
-    if (y_row != y)
+    if (y_row != page)
     {
         // The row position has changed, move to the new row and update the
         // internal row position.
-        y_row = y;                      // Update the cached row position.
-        ks0108b_write (CMD_ROW|CMD_CS12|y); // Set the row on the display.
+        y_row = page;                   // Update the cached row position.
+        ks0108b_write (CMD_ROW|CMD_CS12|page); // Set the row on the display.
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Set the y column. The screen row is mapped to the RAM page that holds it using the display
+/// start line. Where the start line is not aligned then this is the upper
+/// page of the two that hold the row.
+///
+/// @param [in] y The new y position required.
+///
+static void
+set_y_position (uint8_t y)
+{
+    // Map the screen row to the RAM page and ensure y is in the correct
+    // range.
+    set_page ((y + (y_start >> 3)) & 0x7);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write to a chip without waiting for the chip that was written last. The
+/// new chip is selected before the status check so only its status is
+/// polled, the other chip completes its write while this one is written.
+///
+/// @param [in] command The command to write, see ks0108b_write().
+///
+static void
+interleave_write (uint16_t data)
+{
+    uint8_t portc;                      // New portc setting
+
+    // Select the new chip, EN is low so nothing is strobed.
+    portc = data >> 8;
+    PORTC = ((PORTC & ~((1 << CS1) | (1 << CS2))) |
+             (portc & ((1 << CS1) | (1 << CS2))));
+
+    // Wait for the new chip and write the data.
+    status_check (portc);
+    bus_write (portc, data);
+}
+
+#ifdef KS0108B_TIMED_BURST
+// Interleaved writes after the first pair are a timed burst.
+#define interleave_next(data)   ks0108b_burst (data)
+#else
+#define interleave_next(data)   interleave_write (data)
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write a run of data to the addressed column of a chip. The first write
+/// waits for the chip and the rest of the run follows as a burst.
+///
+/// @param [in] cs_select The cs_select bits of the chip.
+/// @param [in] buf The data to write.
+/// @param [in] length The number of columns to write, non-zero.
+/// @param [in] reverse 0xff to invert the data, otherwise 0.
+///
+static void
+chip_run (uint16_t cs_select, uint8_t *buf, uint8_t length, uint8_t reverse)
+{
+    interleave_write (CMD_WRITE | cs_select | (uint8_t)(*buf++ ^ reverse));
+    while (--length > 0)
+        ks0108b_burst (CMD_WRITE | cs_select | (uint8_t)(*buf++ ^ reverse));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write a run of columns of a RAM page to the display. Where the run
+/// covers both chips the writes alternate between the chips, each chip has
+/// its own column address and busy flag so the busy time of one chip is
+/// spent writing the other. Note the chip select lines are swapped, CS2
+/// selects the left chip.
+///
+/// @param [in] page The RAM page.
+/// @param [in] x The first column.
+/// @param [in] end The column after the last.
+/// @param [in] buf The data to write.
+/// @param [in] reverse 0xff to invert the data, otherwise 0.
+///
+static void
+page_write (uint8_t page, uint8_t x, uint8_t end, uint8_t *buf, uint8_t reverse)
+{
+    set_page (page);
+
+    // A run on the right chip only.
+    if (x >= SCREEN_PAGE)
+    {
+        ks0108b_write (CMD_COLUMN | CMD_CS1 | (x & 0x3f));
+        chip_run (CMD_CS1, buf, end - x, reverse);
+    }
+    // A run on the left chip only.
+    else if (end <= SCREEN_PAGE)
+    {
+        ks0108b_write (CMD_COLUMN | CMD_CS2 | x);
+        chip_run (CMD_CS2, buf, end - x, reverse);
+    }
+    else
+    {
+        uint8_t *right;                 // The data of the right chip
+        uint8_t left_len;               // The columns on the left chip
+        uint8_t right_len;              // The columns on the right chip
+
+        left_len = SCREEN_PAGE - x;
+        right_len = end - SCREEN_PAGE;
+        right = &buf [left_len];
+
+        // Address both chips and then alternate the writes while both
+        // chips have columns. The first pair waits for each chip after
+        // the column command.
+        ks0108b_write (CMD_COLUMN | CMD_CS2 | x);
+        ks0108b_write (CMD_COLUMN | CMD_CS1);
+        interleave_write (CMD_WRITE | CMD_CS2 | (uint8_t)(*buf++ ^ reverse));
+        interleave_write (CMD_WRITE | CMD_CS1 | (uint8_t)(*right++ ^ reverse));
+        while ((--left_len > 0) && (--right_len > 0))
+        {
+            interleave_next (CMD_WRITE | CMD_CS2 | (uint8_t)(*buf++ ^ reverse));
+            interleave_next (CMD_WRITE | CMD_CS1 | (uint8_t)(*right++ ^ reverse));
+        }
+
+        // Finish the longer run. When the left run ended first the right
+        // count has not been decremented for the last pair.
+        if (left_len > 0)
+            chip_run (CMD_CS2, buf, left_len, reverse);
+        else if (--right_len > 0)
+            chip_run (CMD_CS1, right, right_len, reverse);
+    }
+}
+
+#ifdef KS0108B_FRAMEBUFFER
+/////////////////////////////////////////////////////////////////////////////
+/// Record a range of columns of a RAM page that have been changed in the
+/// framebuffer and need to be written to the display. A clean page has a
+/// zero end so that nothing is flushed until the driver has drawn.
+///
+/// @param [in] page The RAM page.
+/// @param [in] x The first column changed.
+/// @param [in] end The column after the last column changed.
+///
+static __inline__ void
+frame_dirty (uint8_t page, uint8_t x, uint8_t end)
+{
+    if ((dirty_end [page] == 0) || (dirty_first [page] > x))
+        dirty_first [page] = x;
+    if (dirty_end [page] < end)
+        dirty_end [page] = end;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Read a row of bytes from the framebuffer. This is the framebuffer
+/// version of the display read below, the merge is performed in the same
+/// way but no LCD access is required. Columns beyond the right of the
+/// screen are ignored.
+///
+/// @param [in] x The column to start at.
+/// @param [in] y_row The screen row (y % 8).
+/// @param [in] length The length (number columns) to read.
+/// @param [out] buf The buffer to read the data into.
+/// @param [in] mask The data mask
+/// @param [in] mode The merge operation to perform.
+///
+static void
+read_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mask, uint8_t mode)
+{
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (length > (uint8_t)(SCREEN_WIDTH - x))
+        length = SCREEN_WIDTH - x;
+
+    // Merge the data with the framebuffer.
+    merge_block (&frame [(y_row + (y_start >> 3)) & 0x7][x], buf, length, mask, mode);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write a row to the framebuffer and mark the columns for the next
+/// ks0108b_flush(). Columns beyond the right of the screen are ignored.
+///
+/// @param [in] x The column to write
+/// @param [in] y_row The screen row (y % 8).
+/// @param [in] length The number of columns to write.
+/// @param [in] buf Location to write from.
+/// @param [in] mode The merge mode required.
+///
+void
+write_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mode)
+{
+    uint8_t page;                       // The RAM page
+    uint8_t reverse;                    // Inverts the data
+    uint8_t *screen;                    // The framebuffer position
+
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (length > (uint8_t)(SCREEN_WIDTH - x))
+        length = SCREEN_WIDTH - x;
+
+    page = (y_row + (y_start >> 3)) & 0x7;
+    frame_dirty (page, x, x + length);
+    reverse = ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? 0xff : 0x00;
+
+    // Copy the data, inverted for a reverse.
+    screen = &frame [page][x];
+    do
+        *screen++ = *buf++ ^ reverse;
+    while (--length > 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write the columns of the framebuffer that have changed to the display.
+/// Nothing is written when the framebuffer is unchanged.
+///
+void
+ks0108b_flush (void)
+{
+    uint8_t page;                       // The RAM page
+
+    for (page = 0; page < SCREEN_ROWS; page++)
+    {
+        uint8_t x;                      // The first column
+        uint8_t end;                    // The column after the last
+
+        if ((end = dirty_end [page]) == 0)
+            continue;
+        x = dirty_first [page];
+        dirty_end [page] = 0;
+
+        // Write the columns, interleaving the chips when both changed.
+        page_write (page, x, end, &frame [page][x], 0);
     }
 }
 
+#else
 /////////////////////////////////////////////////////////////////////////////
-/// Read a row of bytes from the screen.
-/// Reads [length] display bytes from page [page] starting at horizontal
-/// value [x] and puts the values in buf automatically accounts for crossing
-/// chips. The command may perform an in-place operation and merge existing
-/// data that is in the buffer as part of the read process depending on the
-/// value of flags.
+/// Read columns of a RAM page of one chip from the display.
+///
+/// @param [in] tag The RAM page and the chip (CACHE_CHIP2).
+/// @param [in] x The chip column to start at.
+/// @param [in] length The number of columns to read, non-zero.
+/// @param [out] buf The buffer to read the data into.
+///
+static void
+chip_read (uint8_t tag, uint8_t x, uint8_t length, uint8_t *buf)
+{
+    uint16_t cs_select;                 // The cs_select bits
+
+    // Note the chip select lines are swapped, CS2 selects the left chip.
+    cs_select = (tag & CACHE_CHIP2) ? CMD_CS1 : CMD_CS2;
+    set_page (tag & 0x7);
+
+    // Set the column position and perform a dummy read to transfer to
+    // register, the column then auto increments on each read.
+    ks0108b_write (CMD_COLUMN | cs_select | x);
+    ks0108b_read (CMD_READ | cs_select);
+    do
+    {
+        *buf++ = ks0108b_read (CMD_READ | cs_select);
+    }
+    while (--length > 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write columns of a RAM page of one chip to the display.
+///
+/// @param [in] tag The RAM page and the chip (CACHE_CHIP2).
+/// @param [in] x The chip column to start at.
+/// @param [in] length The number of columns to write, non-zero.
+/// @param [in] buf The data to write.
+///
+static void
+chip_write (uint8_t tag, uint8_t x, uint8_t length, uint8_t *buf)
+{
+    uint16_t cs_select;                 // The cs_select bits
+
+    cs_select = (tag & CACHE_CHIP2) ? CMD_CS1 : CMD_CS2;
+    set_page (tag & 0x7);
+
+    // Set the column position, the column auto increments on each write.
+    ks0108b_write (CMD_COLUMN | cs_select | x);
+    chip_run (cs_select, buf, length, 0);
+}
+
+#ifdef KS0108B_CACHE
+/////////////////////////////////////////////////////////////////////////////
+/// Make a range of columns of a chip page valid in the page cache. When the
+/// cache holds another page, or a range too far from the new one, it is
+/// written back and restarted. Columns that are about to be overwritten do
+/// not need to be read from the display.
+///
+/// @param [in] tag The RAM page and the chip (CACHE_CHIP2).
+/// @param [in] x The first chip column.
+/// @param [in] end The chip column after the last.
+/// @param [in] read Non-zero if the current display data is required.
+///
+static void
+cache_fetch (uint8_t tag, uint8_t x, uint8_t end, uint8_t read)
+{
+    // Restart the cache if it does not hold the page or the gap to the
+    // valid columns is large.
+    if ((cache_end == 0) || (cache_tag != tag) ||
+        (x > (uint8_t)(cache_end + CACHE_GAP)) ||
+        ((uint8_t)(end + CACHE_GAP) < cache_first))
+    {
+        ks0108b_flush ();
+        cache_tag = tag;
+        cache_first = x;
+        cache_end = x;
+    }
+
+    // Extend the valid columns to the left and to the right.
+    if (x < cache_first)
+    {
+        if (read)
+            chip_read (tag, x, cache_first - x, &cache [x]);
+        else if (end < cache_first)
+            chip_read (tag, end, cache_first - end, &cache [end]);
+        cache_first = x;
+    }
+    if (end > cache_end)
+    {
+        if (cache_end != cache_first)
+        {
+            // Fill any gap between the valid columns and the new columns.
+            if (x > cache_end)
+                chip_read (tag, cache_end, x - cache_end, &cache [cache_end]);
+            else
+                x = cache_end;
+        }
+        if (read)
+            chip_read (tag, x, end - x, &cache [x]);
+        cache_end = end;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Mark a range of the cached columns as changed.
+///
+/// @param [in] x The first chip column changed.
+/// @param [in] end The chip column after the last changed.
+///
+static __inline__ void
+cache_dirty (uint8_t x, uint8_t end)
+{
+    if ((cache_dirty_end == 0) || (cache_dirty_first > x))
+        cache_dirty_first = x;
+    if (cache_dirty_end < end)
+        cache_dirty_end = end;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Read a row of bytes from the screen through the page cache. The command
+/// may perform an in-place operation and merge existing data that is in the
+/// buffer as part of the read process depending on the value of flags.
+/// Columns beyond the right of the screen are ignored.
 ///
 /// @param [in] x The column to start at.
-/// @param [in] page The page (y axis) to process.
+/// @param [in] y_row The screen row (y % 8).
 /// @param [in] length The length (number columns) to read.
 /// @param [out] buf The buffer to read the data into.
 /// @param [in] mask The data mask
@@ -414,184 +932,287 @@ set_y_position (uint8_t y)
 static void
 read_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mask, uint8_t mode)
 {
-    uint8_t s;                          // Distance to edge of chip
-    uint8_t num_bytes1;                 // Side #1 number of bytes
-    uint8_t num_bytes2;                 // Side #2 number of bytes
-    uint16_t cs_select;                 // The cs_select bits
+    uint8_t page;                       // The RAM page
 
-    // Set the y-position enable the display, write to both chips/pages
-    // concurrently.
-    set_y_position (y_row);             // Set row
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (length > (uint8_t)(SCREEN_WIDTH - x))
+        length = SCREEN_WIDTH - x;
+    page = (y_row + (y_start >> 3)) & 0x7;
 
-    // See if we are writing to the 2nd side only accounting for x being
-    // larger than 63
-    if (x >= 64)
+    // Process each chip in turn.
+    do
     {
-        x -= 64;                        // Normalise for chip
-
-        // We are on the 2nd chip first so swap the lcd_read value
-        cs_select = CMD_CS1;
+        uint8_t cx;                     // The chip column
+        uint8_t num_bytes;              // The columns on this chip
+
+        cx = x & 0x3f;
+        num_bytes = SCREEN_PAGE - cx;
+        if (num_bytes > length)
+            num_bytes = length;
+        cache_fetch (page | ((x >= SCREEN_PAGE) ? CACHE_CHIP2 : 0), cx, cx + num_bytes, 1);
+        x += num_bytes;
+        length -= num_bytes;
+
+        // Merge the data with the cache.
+        merge_block (&cache [cx], buf, num_bytes, mask, mode);
+        buf += num_bytes;
     }
-    else
+    while (length > 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write a row to the display through the page cache. Columns beyond the
+/// right of the screen are ignored.
+///
+/// @param [in] x The column to write
+/// @param [in] y_row The row to write (y % 8).
+/// @param [in] length The number of columns to write.
+/// @param [in] buf Location to write from.
+/// @param [in] mode The merge mode required.
+///
+void
+write_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mode)
+{
+    uint8_t page;                       // The RAM page
+    uint8_t reverse;                    // Inverts the data
+
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (length > (uint8_t)(SCREEN_WIDTH - x))
+        length = SCREEN_WIDTH - x;
+    page = (y_row + (y_start >> 3)) & 0x7;
+    reverse = ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? 0xff : 0x00;
+
+    // A whole row is written straight to both chips interleaved. Any cached
+    // columns of the page are overwritten so the cache is discarded.
+    if (length == SCREEN_WIDTH)
     {
-        // We are on the first chip.
-        cs_select = CMD_CS2;
+        if ((cache_tag & 0x7) == page)
+        {
+            cache_end = 0;
+            cache_dirty_end = 0;
+        }
+        page_write (page, 0, SCREEN_WIDTH, buf, reverse);
+        return;
     }
 
-    s = 64 - x;                         // Distance to edge
-    if (length > s)
+    // Process each chip in turn.
+    do
     {
-        num_bytes1 = s;                 // How much to read in the first loop
-        num_bytes2 = length - s;        // How much to read in the second loop
+        uint8_t cx;                     // The chip column
+        uint8_t num_bytes;              // The columns on this chip
+        uint8_t *screen;                // The cached data
+
+        cx = x & 0x3f;
+        num_bytes = SCREEN_PAGE - cx;
+        if (num_bytes > length)
+            num_bytes = length;
+        cache_fetch (page | ((x >= SCREEN_PAGE) ? CACHE_CHIP2 : 0), cx, cx + num_bytes, 0);
+        cache_dirty (cx, cx + num_bytes);
+        x += num_bytes;
+        length -= num_bytes;
+
+        // Copy the data, inverted for a reverse.
+        screen = &cache [cx];
+        do
+            *screen++ = *buf++ ^ reverse;
+        while (--num_bytes > 0);
     }
-    else
+    while (length > 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write back the changed columns of the page cache to the display.
+///
+void
+ks0108b_flush (void)
+{
+    if (cache_dirty_end != 0)
     {
-        num_bytes1 = length;
-        num_bytes2 = 0;
+        chip_write (cache_tag, cache_dirty_first,
+                    cache_dirty_end - cache_dirty_first,
+                    &cache [cache_dirty_first]);
+        cache_dirty_end = 0;
     }
+}
 
-    // Iterate over both sides, we compute the break condition in the loop.
-    for (;;)
+#else
+/////////////////////////////////////////////////////////////////////////////
+/// Read a row of bytes from the screen. The command may perform an
+/// in-place operation and merge existing data that is in the buffer as part
+/// of the read process depending on the value of flags. Columns beyond the
+/// right of the screen are ignored.
+///
+/// @param [in] x The column to start at.
+/// @param [in] y_row The screen row (y % 8).
+/// @param [in] length The length (number columns) to read.
+/// @param [out] buf The buffer to read the data into.
+/// @param [in] mask The data mask
+/// @param [in] mode The merge operation to perform.
+///
+static void
+read_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mask, uint8_t mode)
+{
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (length > (uint8_t)(SCREEN_WIDTH - x))
+        length = SCREEN_WIDTH - x;
+    set_y_position (y_row);
+
+    // Process each chip in turn.
+    do
     {
-        // Set the column position.
-        ks0108b_write (CMD_COLUMN | cs_select | (x & 0x3f));
+        uint16_t cs_select;             // The cs_select bits
+        uint8_t num_bytes;              // The columns on this chip
 
-        // Perform a dummy read to transfer to register
+        // Note the chip select lines are swapped, CS2 selects the left chip.
+        cs_select = (x >= SCREEN_PAGE) ? CMD_CS1 : CMD_CS2;
+        num_bytes = SCREEN_PAGE - (x & 0x3f);
+        if (num_bytes > length)
+            num_bytes = length;
+
+        // Set the column position and perform a dummy read to transfer to
+        // register, the column then auto increments on each read.
+        ks0108b_write (CMD_COLUMN | cs_select | (x & 0x3f));
         ks0108b_read (CMD_READ | cs_select);
+        x += num_bytes;
+        length -= num_bytes;
 
-        // Loop for the number of bytes to be read.
+        // Merge the data with each column as it is read.
         do
         {
-            uint8_t data;
             uint8_t screen_data;
 
-            // Read the data from the screen.
             screen_data = ks0108b_read (CMD_READ | cs_select);
-            data = *buf;
-
-            // Apply any reverse setting; if the reverse bit is set then
-            // we negate the data
-            if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
-                screen_data = ~screen_data;
-
-            // Perform the merge
-            if ((mode & MODE_OP_MASK) != 0)
-                data = merge_column (data, screen_data, mode);
-
-            // MODE_MERGE - Merge in the data in a copy mode
-            data = (data & mask) | (screen_data & ~mask);
-
-            // Assign the data to the buffer.
-            *buf++ = data;
+            merge_block (&screen_data, buf++, 1, mask, mode);
         }
-        while (--num_bytes1 > 0);
-
-        // See if we have finished.
-        if ((num_bytes1 = num_bytes2) == 0)
-            break;
-
-        /* Set up for the next loop */
-        num_bytes1 = num_bytes2;        // Set up for num_bytes1
-        num_bytes2 = 0;                 // Terminate on next loop
-
-        // Select proper chip we move to the other one, this catches any
-        // overrun from previous side.
-        cs_select = CMD_CS1;
-
-        // We have swapped chips so we will start from column 0.
-        x = 0;
+        while (--num_bytes > 0);
     }
+    while (length > 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////
-/// Write a row to the display.
-/// The row is written colum wise where x will start at (x & 0xf8)
+/// Write a row to the display. Columns beyond the right of the screen are
+/// ignored.
 ///
 /// @param [in] x The column to write
-/// @param [in] y_row The row to read (y % 8).
-/// @param [in] length The number of columns to read.
+/// @param [in] y_row The row to write (y % 8).
+/// @param [in] length The number of columns to write.
 /// @param [in] buf Location to write from.
 /// @param [in] mode The merge mode required.
 ///
-void
-write_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mode)
+void
+write_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mode)
+{
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (length > (uint8_t)(SCREEN_WIDTH - x))
+        length = SCREEN_WIDTH - x;
+
+    page_write ((y_row + (y_start >> 3)) & 0x7, x, x + length, buf,
+                ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? 0xff : 0x00);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// The display is written as it is drawn so there is nothing to flush.
+///
+void
+ks0108b_flush (void)
+{
+}
+
+#endif /* KS0108B_CACHE */
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+/// Update a row of the display. The data in the buffer is merged with the
+/// screen when required and written back. When the start line is not
+/// aligned then the row is split over two RAM pages and each page is
+/// updated in turn with the data shifted into position; the buffer is not
+/// modified in this case.
+///
+/// @param [in] x The column to start at.
+/// @param [in] y_row The screen row to update (y % 8).
+/// @param [in] length The number of columns to update.
+/// @param [in,out] buf The data to write.
+/// @param [in] mask The bit mask of the valid bits of the data.
+/// @param [in] mode The merge mode required.
+///
+static void
+update_block (uint8_t x, uint8_t y_row, uint8_t length, uint8_t *buf, uint8_t mask, uint8_t mode)
 {
-    uint8_t s;                          // Distance to edge of chip
-    uint8_t num_bytes1;                 // Side #1 number of bytes
-    uint8_t num_bytes2;                 // Side #2 number of bytes
-    uint16_t cs_select;                 // The cs_select bits
+    uint8_t shift;                      // Shift of the row into the page.
+    uint8_t half;                       // The half of the row.
 
-    // Set the y-position enable the display, write to both chips/pages
-    // concurrently.
-    set_y_position (y_row);             // Set row
-
-    // See if we are writing to the 2nd side only accounting for x being
-    // larger than 63
-    if (x >= 64)
-    {
-        x -= 64;                        // Normalise for chip
-
-        // We are on the 2nd chip first so swap the lcd_read value
-        cs_select = CMD_CS1;
-    }
-    else
+    // The aligned case is a simple read and write of the row.
+    shift = y_start & 0x7;
+    if (shift == 0)
     {
-        // We are on the first chip.
-        cs_select = CMD_CS2;
+        // Read the row in if we need to mix any pixels.
+        if ((mode & (MODE_OP_MASK|MODE_MERGE)) != 0)
+            read_block (x, y_row, length, buf, mask, mode);
+        write_block (x, y_row, length, buf, mode);
+        return;
     }
 
-    s = 64 - x;                         // Distance to edge
-    if (length > s)
-    {
-        num_bytes1 = s;                 // How much to read in the first loop
-        num_bytes2 = length - s;        // How much to read in the second loop
-    }
-    else
+    // The row is split over two pages, the top of the row is at the bottom
+    // of the first page and the bottom of the row at the top of the next.
+    // Only part of each page is written so always merge.
+    mode |= MODE_MERGE;
+    for (half = 0; half < 2; half++)
     {
-        num_bytes1 = length;
-        num_bytes2 = 0;
-    }
+        uint8_t chunk [SPLIT_CHUNK];    // The shifted data
+        uint8_t half_mask;              // The mask for this half
+        uint8_t pos;                    // The position in the row.
 
-    // Iterate over both sides, we compute the break condition in the loop.
-    for (;;)
-    {
-        // Set the column position.
-        ks0108b_write (CMD_COLUMN | cs_select | (x & 0x3f));
+        if (half == 0)
+            half_mask = mask << shift;
+        else
+            half_mask = mask >> (8 - shift);
 
-        // Loop for the number of bytes to be written.
-        do
+        // Skip the page if none of the row falls into it.
+        if (half_mask == 0)
+            continue;
+
+        // Process the row in chunks as we do not have the memory for
+        // a second row.
+        for (pos = 0; pos < length; pos += SPLIT_CHUNK)
         {
-            uint8_t data;
+            uint8_t num_bytes;          // The number of bytes in the chunk
+            uint8_t ii;
 
-            // Get the data from the buffer
-            data = *buf++;
+            num_bytes = length - pos;
+            if (num_bytes > SPLIT_CHUNK)
+                num_bytes = SPLIT_CHUNK;
 
-            // Perform a reverse if required.
-            if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
-                data = ~data;
+            // Shift the data into position for the page.
+            for (ii = 0; ii < num_bytes; ii++)
+            {
+                if (half == 0)
+                    chunk [ii] = buf [pos + ii] << shift;
+                else
+                    chunk [ii] = buf [pos + ii] >> (8 - shift);
+            }
 
-            // Write the data to the screen.
-            ks0108b_write (CMD_WRITE | cs_select | data);
+            read_block (x + pos, y_row + half, num_bytes, chunk, half_mask, mode);
+            write_block (x + pos, y_row + half, num_bytes, chunk, mode);
         }
-        while (--num_bytes1 > 0);
-
-        // See if we have finished.
-        if ((num_bytes1 = num_bytes2) == 0)
-            break;
-
-        /* Set up for the next loop */
-        num_bytes1 = num_bytes2;        // Set up for num_bytes1
-        num_bytes2 = 0;                 // Terminate on next loop
-
-        // Select proper chip we move to the other one, this catches any
-        // overrun from previous side.
-        cs_select = CMD_CS1;
-
-        // We have swapped chips so we will start from column 0.
-        x = 0;
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Set the display start line.
+///
+/// @param [in] line The RAM line to display at the top of the screen.
+///
+static void
+set_start_line (uint8_t line)
+{
+    y_start = line & SCREEN_HEIGHT_MASK;
+    ks0108b_write (CMD_START_LINE | CMD_CS12 | y_start);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 /// First unitialisation of the device. Set up the display hardware.
 ///
@@ -614,6 +1235,9 @@ ks0108b_init (void)
 
     // Reset the column cache position.
     y_row = 0xff;
+
+    // Display from the top of RAM.
+    set_start_line (0);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -633,6 +1257,21 @@ ks0108b_screen_clear (uint8_t mode)
     // 0x00 when reversed we write 0xff. Note: 0x00-0x01 = 0xff !!
     data = (mode & MODE_NORMAL_MASK) - 1;
 
+    // Undo any scroll so that the rows are aligned with the pages again.
+    if (y_start != 0)
+        set_start_line (0);
+
+#ifdef KS0108B_FRAMEBUFFER
+    // Clear the framebuffer. The display is still cleared directly as both
+    // chips are written at once, so there is nothing left to flush.
+    memset (frame, data, sizeof (frame));
+    memset (dirty_end, 0, sizeof (dirty_end));
+#elif defined(KS0108B_CACHE)
+    // Discard the page cache, any changes are overwritten by the clear.
+    cache_end = 0;
+    cache_dirty_end = 0;
+#endif
+
     // Iterate over all of the rows.
     for (yy = 0; yy < SCREEN_ROWS; yy++)
     {
@@ -643,14 +1282,17 @@ ks0108b_screen_clear (uint8_t mode)
         set_y_position (yy);            // Set row
         ks0108b_write(CMD_COLUMN|CMD_CS12); // Set column
 
-        // Write the data
-        for (xx = 0; xx < SCREEN_PAGE; xx++)
-            ks0108b_write (CMD_WRITE | CMD_CS12 | data);
+        // Write the data, the columns after the first are a burst.
+        ks0108b_write (CMD_WRITE | CMD_CS12 | data);
+        for (xx = 1; xx < SCREEN_PAGE; xx++)
+            ks0108b_burst (CMD_WRITE | CMD_CS12 | data);
     }
 }
 
 /////////////////////////////////////////////////////////////////////////////
-/// Scroll the display up by 1 line.
+/// Scroll the display vertically. The display start line is moved so the
+/// screen contents are not copied, only the band of lines that scrolls onto
+/// the screen is cleared.
 ///
 /// @param [in] buf The buffer to use for reading and writing
 /// @param [in] pixels The number of pixels to scroll where -ve is up
@@ -659,25 +1301,256 @@ ks0108b_screen_clear (uint8_t mode)
 void
 ks0108b_vscroll (uint8_t *buf, int8_t pixels, uint8_t mode)
 {
-    uint8_t yy;                         // The y coordinate.
-    
-    // TODO: Currently we ignore pixels and simple do -8.
-    
+    uint8_t first;                      // The first line to clear.
+    uint8_t last;                       // The last line to clear.
+    uint8_t yy;                         // The y row.
+
     // Only use the normal and reverse mode
     mode &= MODE_NORMAL_MASK;
-    
-    // Iterate over all of the rows.
-    for (yy = 0; yy < SCREEN_ROWS; yy++)
+
+    // Nothing to do, or the whole screen scrolls off.
+    if (pixels == 0)
+        return;
+    if ((pixels <= -SCREEN_HEIGHT) || (pixels >= SCREEN_HEIGHT))
+    {
+        ks0108b_screen_clear (mode);
+        return;
+    }
+
+    // Determine the band of lines that will scroll onto the screen.
+    if (pixels < 0)
+    {
+        first = SCREEN_HEIGHT + pixels;
+        last = SCREEN_HEIGHT - 1;
+    }
+    else
+    {
+        first = 0;
+        last = pixels - 1;
+    }
+
+    // Move the start line, the screen contents move with it.
+    set_start_line (y_start - pixels);
+
+    // Clear the band of lines that has wrapped around onto the screen.
+    for (yy = first >> 3; yy <= (last >> 3); yy++)
+    {
+        uint8_t mask;                   // The lines of the row to clear
+
+        mask = 0xff;
+        if (yy == (first >> 3))
+            mask &= 0xff << (first & 7);
+        if (yy == (last >> 3))
+            mask &= 0xff >> (7 - (last & 7));
+
+        // Clear the line, merging when only part of the row is cleared.
+        memset (buf, 0, SCREEN_WIDTH);
+        update_block (0, yy, SCREEN_WIDTH, buf, mask,
+                      (mask == 0xff) ? mode : (mode | MODE_MERGE));
+    }
+}
+
+#ifdef FONT_WINDOW
+/////////////////////////////////////////////////////////////////////////////
+/// Scroll a window of the display up. The start line moves the whole screen
+/// so the window is copied instead, each row of the window is composed from
+/// the two rows that its source lines straddle and is written back with the
+/// lines outside of the window merged. The lines that scroll into the bottom
+/// of the window are cleared. The rows are processed a chip page of columns
+/// at a time through the draw_buffer.
+///
+/// @param [in] x0 The left x-coordinate of the window.
+/// @param [in] y0 The top y-coordinate of the window.
+/// @param [in] x1 The right x-coordinate of the window.
+/// @param [in] y1 The bottom y-coordinate of the window.
+/// @param [in] pixels The number of pixels to scroll up.
+/// @param [in] mode The current mode.
+///
+void
+ks0108b_wscroll (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t pixels, uint8_t mode)
+{
+    uint8_t *upper = draw_buffer;       // The source row of the top lines
+    uint8_t *lower = &draw_buffer [SCREEN_PAGE]; // The next source row
+    uint8_t last;                       // The last line that is copied.
+    uint8_t yy;                         // The first line of the row.
+
+    // Only use the normal and reverse mode
+    mode &= MODE_NORMAL_MASK;
+
+    // Nothing to do.
+    if (pixels == 0)
+        return;
+    last = y1 - pixels;
+
+    for (yy = y0 & ~0x7; yy <= y1; yy += 8)
+    {
+        uint8_t mask;                   // The lines of the window in the row
+        uint8_t copy;                   // The lines copied from below
+        uint8_t source;                 // The position of the source lines
+        uint8_t shift;                  // The shift of the source lines
+        uint8_t xx;                     // The column.
+
+        mask = 0xff;
+        if (y0 > yy)
+            mask <<= y0 - yy;
+        if (y1 < yy + 7)
+            mask &= 0xff >> (yy + 7 - y1);
+
+        // The lines that receive a line from below, the remainder are
+        // cleared.
+        copy = 0;
+        if ((pixels <= (uint8_t)(y1 - y0)) && (last >= yy))
+        {
+            copy = mask;
+            if (last < yy + 7)
+                copy &= 0xff >> (yy + 7 - last);
+        }
+
+        // The source lines start part way into a row when the start line or
+        // the scroll is not aligned.
+        source = yy + pixels + (y_start & 0x7);
+        shift = source & 0x7;
+        source >>= 3;
+
+        for (xx = x0; xx <= x1; xx += SCREEN_PAGE)
+        {
+            uint8_t num_bytes;          // The columns of the chunk
+            uint8_t ii;
+
+            num_bytes = x1 - xx + 1;
+            if (num_bytes > SCREEN_PAGE)
+                num_bytes = SCREEN_PAGE;
+
+            if (copy == 0)
+                memset (upper, 0, num_bytes);
+            else
+            {
+                // Read the source lines and shift them into the row.
+                read_block (xx, source, num_bytes, upper, 0x00, mode);
+                if (shift != 0)
+                    read_block (xx, source + 1, num_bytes, lower, 0x00, mode);
+                for (ii = 0; ii < num_bytes; ii++)
+                {
+                    uint8_t data = upper [ii] >> shift;
+
+                    if (shift != 0)
+                        data |= lower [ii] << (8 - shift);
+                    upper [ii] = data & copy;
+                }
+            }
+
+            // Write the row, merging the lines outside of the window.
+            update_block (xx, yy >> 3, num_bytes, upper, mask,
+                          (mask == 0xff) ? mode : (mode | MODE_MERGE));
+        }
+    }
+}
+#endif /* FONT_WINDOW */
+
+/////////////////////////////////////////////////////////////////////////////
+/// Copy a rectangle of the display to another position. Each row of the
+/// destination is composed from the two rows that its source lines straddle
+/// and is written back with the lines outside of the rectangle merged, as
+/// ks0108b_wscroll(). The rows and the chunks of a chip page of columns are
+/// processed in the order that reads the source lines before they are
+/// overwritten so the rectangles may overlap.
+///
+/// @param [in] sx The left x-coordinate of the source.
+/// @param [in] sy The top y-coordinate of the source.
+/// @param [in] width The width of the rectangle in pixels.
+/// @param [in] height The height of the rectangle in pixels.
+/// @param [in] dx The left x-coordinate of the destination.
+/// @param [in] dy The top y-coordinate of the destination.
+/// @param [in] mode The merging mode of the copy.
+///
+void
+ks0108b_copy_rect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                   uint8_t dx, uint8_t dy, uint8_t mode)
+{
+    uint8_t *upper = draw_buffer;       // The source row of the top lines
+    uint8_t *lower = &draw_buffer [SCREEN_PAGE]; // The next source row
+    uint8_t last;                       // The last line of the destination.
+    uint8_t yy;                         // The first line of the row.
+    uint8_t rows;                       // The rows to copy.
+
+    last = dy + height - 1;
+    rows = (last >> 3) - (dy >> 3) + 1;
+
+    // Copy from the bottom up when moving down so that the source lines are
+    // read before they are overwritten.
+    if (dy > sy)
+        yy = last & ~0x7;
+    else
+        yy = dy & ~0x7;
+
+    do
     {
-        // Read in display data or clear the line
-        if (yy == (SCREEN_ROWS - 1))
-            memset (buf, 0, SCREEN_WIDTH);
+        uint8_t mask;                   // The lines of the rectangle in the row
+        uint8_t source;                 // The position of the source lines
+        uint8_t shift;                  // The shift of the source lines
+        uint8_t pos;                    // The offset of the chunk.
+        uint8_t ii;
+
+        mask = 0xff;
+        if (dy > yy)
+            mask <<= dy - yy;
+        if (last < yy + 7)
+            mask &= 0xff >> (yy + 7 - last);
+
+        // The source lines start part way into a row when the start line or
+        // the copy is not aligned. A source above the top of the row wraps
+        // but only the lines under the mask are used.
+        source = yy + sy - dy + (y_start & 0x7);
+        shift = source & 0x7;
+        source >>= 3;
+
+        // Copy the chunks from the right when moving right.
+        pos = 0;
+        if (dx > sx)
+            pos = (width - 1) & ~(SCREEN_PAGE - 1);
+        for (;;)
+        {
+            uint8_t num_bytes;          // The columns of the chunk
+
+            num_bytes = width - pos;
+            if (num_bytes > SCREEN_PAGE)
+                num_bytes = SCREEN_PAGE;
+
+            // Read the source lines and shift them into the row.
+            read_block (sx + pos, source, num_bytes, upper, 0x00, mode & MODE_NORMAL_MASK);
+            if (shift != 0)
+            {
+                read_block (sx + pos, source + 1, num_bytes, lower, 0x00, mode & MODE_NORMAL_MASK);
+                for (ii = 0; ii < num_bytes; ii++)
+                    upper [ii] = (upper [ii] >> shift) | (lower [ii] << (8 - shift));
+            }
+
+            // Write the row, merging the lines outside of the rectangle.
+            update_block (dx + pos, yy >> 3, num_bytes, upper, mask,
+                          (mask == 0xff) ? mode : (mode | MODE_MERGE));
+
+            // Move onto the next chunk.
+            if (dx > sx)
+            {
+                if (pos == 0)
+                    break;
+                pos -= SCREEN_PAGE;
+            }
+            else
+            {
+                pos += SCREEN_PAGE;
+                if (pos >= width)
+                    break;
+            }
+        }
+
+        // Move onto the next row.
+        if (dy > sy)
+            yy -= 8;
         else
-            read_block (0, yy + 1, SCREEN_WIDTH, buf, 0x00, mode);
-        
-        // Write data back to screen
-        write_block (0, yy, SCREEN_WIDTH, buf, mode);
+            yy += 8;
     }
+    while (--rows > 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -701,6 +1574,89 @@ ks0108b_screen_reverse (uint8_t *buf)
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Write a single column of a RAM page. The column is merged and written in
+/// the framebuffer or the page cache and reaches the display on the next
+/// ks0108b_flush(), without either the column is read and written directly.
+///
+/// @param [in] x     The column to write.
+/// @param [in] y_row The row to re-write (y % 8).
+/// @param [in] data The data to write.
+/// @param [in] mask The bit mask of the valid bits of the data.
+/// @param [in] mode Merging modification operation to perform.
+///
+static void
+write_column (uint8_t x, uint8_t y_row, uint8_t data, uint8_t mask, uint8_t mode)
+{
+    uint8_t page;                       // The RAM page
+    uint8_t *screen;                    // The current data
+#if !defined(KS0108B_FRAMEBUFFER) && !defined(KS0108B_CACHE)
+    uint8_t column = 0;                 // The column read from the display
+#endif
+
+    if (x >= SCREEN_WIDTH)
+        return;
+    page = (y_row + (y_start >> 3)) & 0x7;
+
+#ifdef KS0108B_FRAMEBUFFER
+    screen = &frame [page][x];
+#else
+    if (x >= SCREEN_PAGE)
+    {
+        x -= SCREEN_PAGE;
+        page |= CACHE_CHIP2;
+    }
+#ifdef KS0108B_CACHE
+    cache_fetch (page, x, x + 1, mode & MODE_MODIFIER);
+    screen = &cache [x];
+#else
+    if ((mode & MODE_MODIFIER) != 0)
+        chip_read (page, x, 1, &column);
+    screen = &column;
+#endif
+#endif
+
+    // Handle any merging with the current data.
+    if ((mode & MODE_MODIFIER) != 0)
+    {
+        uint8_t screen_data;
+
+        screen_data = *screen;
+
+        // Apply any reverse setting; if the reverse bit is set then we
+        // negate the data
+        if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
+            screen_data = ~screen_data;
+
+        // Perform the merge
+        if ((mode & MODE_OP_MASK) != 0)
+            data = merge_column (data, screen_data, mode);
+
+        // MODE_MERGE - Merge in the data in a copy mode
+        data = (data & mask) | (screen_data & ~mask);
+    }
+
+    // Apply any reverse setting; if the reverse bit is set then we
+    // negate the data
+    if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
+        data = ~data;
+
+#ifdef KS0108B_FRAMEBUFFER
+    // Only mark the column when it has changed.
+    if (*screen != data)
+    {
+        *screen = data;
+        frame_dirty (page, x, x + 1);
+    }
+#elif defined(KS0108B_CACHE)
+    // A column that was not read may hold stale data so always mark it.
+    *screen = data;
+    cache_dirty (x, x + 1);
+#else
+    chip_write (page, x, 1, &data);
+#endif
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /// Sets/Draws a single column to the screen.
 /// The column is read row wise where y is (y & 0xf8)
@@ -741,55 +1697,21 @@ ks0108b_screen_reverse (uint8_t *buf)
 void
 ks0108b_set_column (uint8_t x, uint8_t y_row, uint8_t data, uint8_t mask, uint8_t mode)
 {
-    uint16_t cs_select;
-
-    // Set the y-position enable the display, write to both chips/pages
-    // concurrently.
-    set_y_position (y_row);              // Set row
-
-    // Set the x-position chip select.
-    if (x < 64)
-        cs_select = CMD_CS2;
-    else
-        cs_select = CMD_CS1;
-
-    // Set the column we are writing.
-    ks0108b_write (CMD_COLUMN | cs_select | (x & 0x3f)); // Set column
+    uint8_t shift;                      // Shift of the row into the page.
 
-    // Handle any buffer merging on the read.
-    if ((mode & MODE_MODIFIER) != 0)
+    // When the start line is not aligned then the column is split over two
+    // pages; write each part with a merge so the rest of the page is kept.
+    shift = y_start & 0x7;
+    if (shift != 0)
     {
-        uint8_t screen_data;
-
-        // Perform a dummy read to transfer to register
-        ks0108b_read (CMD_READ | cs_select);
-
-        // We need to perform a merge. Get the data from controller
-        screen_data = ks0108b_read (CMD_READ | cs_select);
-
-        // Apply any reverse setting; if the reverse bit is set then we
-        // negate the data
-        if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
-            screen_data = ~screen_data;
-
-        // Perform the merge
-        if ((mode & MODE_OP_MASK) != 0)
-            data = merge_column (data, screen_data, mode);
-
-        // MODE_MERGE - Merge in the data in a copy mode
-        data = (data & mask) | (screen_data & ~mask);
-
-        // Reset the position ready to write the data.
-        ks0108b_write (CMD_COLUMN | cs_select | (x & 0x3f));
+        mode |= MODE_MERGE;
+        if ((uint8_t)(mask << shift) != 0)
+            write_column (x, y_row, data << shift, mask << shift, mode);
+        if ((mask >> (8 - shift)) != 0)
+            write_column (x, y_row + 1, data >> (8 - shift), mask >> (8 - shift), mode);
     }
-
-    // Apply any reverse setting; if the reverse bit is set then we
-    // negate the data
-    if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
-        data = ~data;
-
-    // Write the data.
-    ks0108b_write (CMD_WRITE | cs_select | data);
+    else
+        write_column (x, y_row, data, mask, mode);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -909,6 +1831,7 @@ ks0108b_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mo
     uint8_t shift_bot;                  // Shift to move to lower part of page.
     uint8_t mask_top;                   // Top line mask.
     uint8_t mask_bot;                   // Bottom line mask
+    uint8_t *buf;                       // The row to write
     int offset;                         // Offset into the data
 
     // Calculate how much to shift the data bytes to line them up with the
@@ -1033,97 +1956,105 @@ ks0108b_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mo
             mode &= ~MODE_MERGE;
         }
         
-        // Loop for columns
-        for (col = 0; col < width; col++)
+        // Collect the image row into the buffer. The source and the
+        // operation are fixed for the row so each combination has its own
+        // column loop.
+        buf = draw_buffer;
+        if (source < SOURCE_DATA_PTR)
         {
-            uint8_t temp;               // The currently process column data
-            
-            if (source < SOURCE_DATA_PTR)
+            // Use the static data that was passed.
+            memset (draw_buffer, *data, width);
+        }
+        else if (source == SOURCE_DATA_PTR)
+        {
+            // Handle the data passed in
+
+            // Operation 1: Not aligned, process the top row only. Get the
+            // data for the first row for the bottom of the page.
+            if (operation == OPERATION_TOP)
             {
-                // Use the static data that was passed.
-                temp = *data;
+                for (col = 0; col < width; col++)
+                    draw_buffer[col] = data[col] << shift_top;
             }
-            else if (source == SOURCE_DATA_PTR)
+            else
             {
-                // Handle the data passed in 
-                
-                // Operation 1: Not aligned, process the top row only.
-                if (operation == OPERATION_TOP)
+                uint8_t *src = &data[offset];
+
+                // Move to the next row of the data.
+                offset += width;
+
+                // Operation 3: Aligned data pass through without relocating.
+                // When nothing is merged the row is only read by the write
+                // so the data is written directly, otherwise it is copied
+                // as the merge is performed in the buffer.
+                if (operation == OPERATION_ALIGNED)
                 {
-                    // Get the data for the first row for the bottom of the
-                    // page. 
-                    temp = data[col] << shift_top;
+                    if ((mode & (MODE_OP_MASK|MODE_MERGE)) == 0)
+                        buf = src;
+                    else
+                        memmove (draw_buffer, src, width);
                 }
+                // Operation 2: Not aligned, look ahead. If we are mid row
+                // (not first or last) and non-aligned then get the bottom of
+                // the column from the next row which is exactly 'width'
+                // bytes ahead.
+                else if (operation == OPERATION_MIDDLE)
+                {
+                    for (col = 0; col < width; col++)
+                        draw_buffer[col] = ((src[col] >> shift_bot) |
+                                            (src[col + width] << shift_top));
+                }
+                // Operation 1: Not aligned, bottom line.
                 else
                 {
-                    // Get the data from the current position for the top of
-                    // the page. 
-                    temp = data[offset];
-                    
-                    if (operation > OPERATION_ALIGNED)
-                    {
-                        // Operation 2: Not aligned, look ahead. If we are
-                        // mid row (not first or last) and non-aligned then
-                        // look ahead and get the bottom of the column from
-                        // the next byte that is in the RX buffer. This will
-                        // be exactly 'width' bytes ahead. 
-                        if (operation == OPERATION_MIDDLE)
-                        {
-                            // Get the data for the bottom from the next row.
-                            temp >>= shift_bot;
-                            temp |= data[offset + width] << shift_top;
-                        }
-                        // Operation 1: Not aligned. 
-                        else
-                            temp = (temp << shift_top) | (temp >> shift_bot);
-                    }
-                    
-                    // Operation 3: Aligned data pass through without relocating.
-                    // Move to the next.
-                    offset++;
+                    for (col = 0; col < width; col++)
+                        draw_buffer[col] = ((src[col] << shift_top) |
+                                            (src[col] >> shift_bot));
                 }
             }
-            else
+        }
+        else
+        {
+            // Handle the passed from the serial.
+
+            // Operation 1: Not aligned, process the top row only.
+            if (operation == OPERATION_TOP)
+            {
+                for (col = 0; col < width; col++)
+                    draw_buffer[col] = serial_peek (col) << shift_top;
+            }
+            // Operation 3: Aligned data pass through without relocating.
+            else if (operation == OPERATION_ALIGNED)
+            {
+                for (col = 0; col < width; col++)
+                    draw_buffer[col] = serial_getc ();
+            }
+            // Operation 2: Not aligned, look ahead. Read the value of the
+            // data ahead of us in the RX buffer, this will be exactly
+            // 'width' bytes ahead, and shift into the correct position.
+            else if (operation == OPERATION_MIDDLE)
             {
-                // Handle the passed from the serial.
-                
-                // Operation 1: Not aligned, process the top row only.
-                if (operation == OPERATION_TOP)
+                for (col = 0; col < width; col++)
                 {
-                    temp = serial_peek (col) << shift_top;
+                    uint8_t temp;       // The currently process column data
+
+                    temp = serial_getc () >> shift_bot;
+                    draw_buffer[col] = temp | (serial_peek (width - 1) << shift_top);
                 }
-                else
+            }
+            // Operation 1: Not aligned, bottom line.
+            else
+            {
+                for (col = 0; col < width; col++)
                 {
-                    // Read a byte from the serial and align with the page
-                    // boundary.
-                    temp = serial_getc ();
+                    uint8_t temp;       // The currently process column data
 
-                    if (operation > OPERATION_ALIGNED)
-                    {
-                        // Operation 2: Not aligned, look ahead. If we are
-                        // mid row (not first or last) and non-aligned then
-                        // look ahead and get the bottom of the column from
-                        // the next byte that is in the RX buffer. This will
-                        // be exactly 'width' bytes ahead. 
-                        if (operation == OPERATION_MIDDLE)
-                        {
-                            // Read the value of the data ahead of us and
-                            // shift into the correct position. 
-                            temp >>= shift_bot;
-                            temp |= serial_peek (width - 1) << shift_top;
-                        }
-                        else
-                        {
-                            // Bottom line.
-                            temp = (temp << shift_top) | (temp >> shift_bot);
-                        }
-                    }
+                    temp = serial_getc ();
+                    draw_buffer[col] = (temp << shift_top) | (temp >> shift_bot);
                 }
             }
-            // Write the data to the buffer
-            draw_buffer[col] = temp;
         }
-            
+
         // If NULL was passed for data, take it from the serial port. It is
         // necessary to have 2 rows of data, current and previous to do
         // bitblt since 0<width<128 (display is only 128 wide), we can use
@@ -1133,13 +2064,7 @@ ks0108b_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mo
         // writing a complete row and we are not mxing in any pixels. We
         // perform the read when (merge mode) || (first row shifted) || (last
         // row shifted).
-        if ((mode & (MODE_OP_MASK|MODE_MERGE)) != 0)
-        {
-            // We need to perfom some mixing so read the data.
-            read_block (x, y, width, draw_buffer, mask, mode);
-        }
-        // Write the data back.
-        write_block (x, y, width, draw_buffer, mode & (MODE_OP_MASK | MODE_NORMAL));
+        update_block (x, y, width, buf, mask, mode);
         y++;
     }//row loop
     
@@ -1148,6 +2073,124 @@ ks0108b_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mo
         serial_flushc (width);
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Flip bitblt data from horizontal to vertical layout. This is the reverse
+/// of the T6963 conversion, 8 rows with the most significant bit on the
+/// left become 8 columns with the least significant bit at the top.
+///
+/// @param [in,out] buf An 8x8 buffer of data to be reorganised in-place.
+///
+static __inline__ void
+flip_8x8_h_to_v (uint8_t *buf)
+{
+    uint8_t dest [8];
+    int8_t xx;
+    int8_t yy;
+
+    // Flip the bits.
+    yy = 7;
+    do
+    {
+        uint8_t datum = buf[yy];
+        xx = 7;
+        do
+        {
+            dest[xx] = (dest[xx] << 1) | (datum & 0x01);
+            datum >>= 1;
+        }
+        while (--xx >= 0);
+    }
+    while (--yy >= 0);
+
+    // Copy the results back
+    xx = 7;
+    do
+    {
+        buf[xx] = dest[xx];
+    }
+    while (--xx >= 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Horizontal bitblt does a bit transfer of row organised data to display
+/// memory. Each row is (width + 7) / 8 bytes with the most significant bit
+/// on the left. The display is organised in vertical bytes so each band of
+/// 8 rows is collected, transposed 8x8 at a time and passed to
+/// ks0108b_vbitblt(). If NULL is passed as data, bitblt takes the data
+/// from the serial port.
+///
+/// @param [in] x,y is upper left corner of image in pixels.
+/// @param [in] width The width of the image in pixels.
+/// @param [in] height The height of the image in pixels.
+/// @param [in] mode determines how the bits in the image combine with the
+///             bits already present on the display, see ks0108b_vbitblt().
+///             MODE_FILL is not supported.
+/// @param [in] data The row data or NULL for serial.
+///
+void
+ks0108b_hbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode, uint8_t *data)
+{
+    uint8_t row_bytes;                  // The bytes in a row of the image
+    uint8_t row;                        // The first row of the band
+    uint8_t rows;                       // The rows in the current band
+    uint8_t *band;                      // The band of rows
+
+    // The band is kept clear of the start of the draw_buffer which is used
+    // by ks0108b_vbitblt(). Each 8x8 block is stored contiguously so that it
+    // may be transposed in place.
+    band = &draw_buffer [SCREEN_MAX_WIDTH - 128];
+    row_bytes = (width + 7) >> 3;
+
+    // Iterate over the bands of 8 rows.
+    for (row = 0; row < height; row += rows)
+    {
+        uint16_t col;                   // The current column
+        uint8_t ii;                     // The current row in the band
+        uint8_t jj;                     // The current block in the row
+
+        rows = height - row;
+        if (rows > 8)
+            rows = 8;
+
+        // Collect the band.
+        for (ii = 0; ii < rows; ii++)
+        {
+            for (jj = 0; jj < row_bytes; jj++)
+            {
+                if (data == NULL)
+                    band [(jj << 3) + ii] = serial_getc ();
+                else
+                    band [(jj << 3) + ii] = *data++;
+            }
+        }
+
+        // Discard bands below the screen and clip the band to the bottom of
+        // the screen.
+        if (((uint16_t) y + row) >= SCREEN_HEIGHT)
+            continue;
+        ii = rows;
+        if ((y + row + ii) > SCREEN_HEIGHT)
+            ii = SCREEN_HEIGHT - (y + row);
+
+        // Transpose and write each block that is on the screen, clipping the
+        // last block to the right of the screen.
+        col = x;
+        for (jj = 0; (jj < row_bytes) && (col < SCREEN_WIDTH); jj++, col += 8)
+        {
+            uint8_t *block = &band [jj << 3];
+            uint8_t block_width = width - (jj << 3);
+
+            if (block_width > 8)
+                block_width = 8;
+            if ((col + block_width) > SCREEN_WIDTH)
+                block_width = SCREEN_WIDTH - col;
+
+            flip_8x8_h_to_v (block);
+            ks0108b_vbitblt (col, y + row, block_width, ii, mode, block);
+        }
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /// Draw a horizontal line
 ///
@@ -1203,8 +2246,7 @@ ks0108b_hline (uint8_t x, uint8_t y, uint8_t x1, uint8_t mode)
             draw_buffer [SCREEN_HEIGHT + ii] = pixel_mask;
 
         // Read the block in with a modification and then write it back.
-        read_block (x, y, width, &draw_buffer [SCREEN_HEIGHT], pixel_mask, mode | MODE_MERGE);
-        write_block (x, y, width, &draw_buffer [SCREEN_HEIGHT], mode | MODE_MERGE);
+        update_block (x, y, width, &draw_buffer [SCREEN_HEIGHT], pixel_mask, mode | MODE_MERGE);
 
         // See if there is another block to do.
         if (width2 == 0)
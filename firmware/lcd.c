@@ -186,6 +186,14 @@ lcd_factory_reset (void)
     {
         eeprom_write_byte (ptr++, 0);
     }
+
+#if EEPROM_LIST_NUM > 0
+    // Clear the EEPROM display lists.
+    for (ii = 0; ii < EEPROM_LIST_NUM; ii++)
+    {
+        eeprom_write_byte ((uint8_t *)(EEPROM_ADDR_LIST_START + (ii * EEPROM_LIST_SIZE)), 0);
+    }
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,541 @@
+/* -*- c++ -*- ***************************************************************
+ *
+ *  System        : Serial GLCD
+ *  Module        : Display lists
+ *
+ *  Description   : Records sequences of commands received from the serial
+ *                  port and replays them on request.
+ *
+ *  Notes         : A display list is the raw byte stream that the host sent
+ *                  between a CMDX_LIST_BEGIN and a CMDX_LIST_END. The list
+ *                  is replayed by feeding the bytes back through
+ *                  serial_getc() so that main() dispatches them exactly as
+ *                  if they had been received from the host.
+ *
+ *                  A list may also be used as a template. The byte
+ *                  LIST_ESCAPE followed by n is replaced by argument n when
+ *                  the list is replayed; LIST_ESCAPE LIST_ESCAPE is a
+ *                  literal LIST_ESCAPE. Recorded lists escape any
+ *                  LIST_ESCAPE bytes they capture so that they replay
+ *                  unchanged.
+ *
+ *                  The display lists are only built with DISPLAY_LIST.
+ *
+ *  History       :
+ *
+ *****************************************************************************
+ *
+ *  Part of the Serial GLCD firmware, distributed under the MIT license in
+ *  LICENSE.txt.
+ *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+
+#include "glcd.h"
+
+#ifdef DISPLAY_LIST
+
+// The display list store. Each list is held as [id][length][bytes...] and
+// the lists are packed from the start of the store in the order that they
+// were recorded.
+static uint8_t list_store [LIST_STORE_SIZE];
+
+// The number of bytes of the store that are in use.
+static uint16_t list_used;
+
+// The position of the header of the list that is being recorded.
+static uint16_t list_record_pos;
+
+// The recording state; LIST_RECORD_OFF, LIST_RECORD_ON or
+// LIST_RECORD_OVERFLOW.
+uint8_t list_recording;
+
+// The replay stack. Each frame holds the position of the next byte to replay
+// and the end of the list. Positions in EEPROM are marked with
+// LIST_POS_EEPROM. A repeated list restarts from start until count runs out.
+static struct
+{
+    uint16_t pos;                       // Next byte to replay
+    uint16_t end;                       // End of the list
+    uint16_t start;                     // Start of the list
+    uint8_t count;                      // Number of times left to replay
+} list_frame [LIST_DEPTH];
+
+// The number of lists being replayed.
+uint8_t list_depth;
+
+// The template arguments and the steps applied to them on each repeat. The
+// arguments are shared by all lists.
+static uint8_t list_args [LIST_ARGS];
+static int8_t list_steps [LIST_ARGS];
+
+// Marks a list position as an EEPROM address.
+#define LIST_POS_EEPROM   0x8000
+
+/////////////////////////////////////////////////////////////////////////////
+/// Find a list in the RAM store. The list that is being recorded has no
+/// length yet so the search stops at its header.
+///
+/// @param [in] id The identity of the list.
+///
+/// @return A pointer to the list header or NULL if the list does not exist.
+///
+static uint8_t *
+list_find (uint8_t id)
+{
+    uint8_t *ptr = list_store;
+    uint8_t *end;
+
+    if (list_recording != LIST_RECORD_OFF)
+        end = &list_store [list_record_pos];
+    else
+        end = &list_store [list_used];
+
+    while (ptr < end)
+    {
+        if (ptr[0] == id)
+            return ptr;
+        ptr += ptr[1] + 2;
+    }
+    return NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Read a byte of a list from the RAM or EEPROM store.
+///
+/// @param [in] pos The position of the byte.
+///
+/// @return The byte at the position.
+///
+static uint8_t
+list_read (uint16_t pos)
+{
+#if EEPROM_LIST_NUM > 0
+    if (pos & LIST_POS_EEPROM)
+        return eeprom_read_byte ((const uint8_t *)(pos & ~LIST_POS_EEPROM));
+#endif
+    return list_store [pos];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Read the next byte of a list and substitute any argument.
+///
+/// @param [in,out] pos The position of the byte, advanced past the byte.
+///
+/// @return The byte with any argument substituted.
+///
+static uint8_t
+list_next (uint16_t *pos)
+{
+    uint8_t cc;
+
+    cc = list_read ((*pos)++);
+    if (cc == LIST_ESCAPE)
+    {
+        // An escape is followed by the argument number or a literal escape.
+        cc = list_read ((*pos)++);
+        if (cc < LIST_ARGS)
+            cc = list_args [cc];
+    }
+    return cc;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Create a new empty list at the end of the store. Any existing list with
+/// the same identity is deleted.
+///
+/// @param [in] id The identity of the list.
+///
+/// @return Non-zero if there is room in the store for the list header.
+///
+static uint8_t
+list_new (uint8_t id)
+{
+    uint8_t *ptr;
+
+    // Delete any existing list with the same identity.
+    if ((ptr = list_find (id)) != NULL)
+    {
+        uint8_t length = ptr[1] + 2;
+
+        list_used -= length;
+        memmove (ptr, ptr + length, &list_store [list_used] - ptr);
+    }
+
+    // Write the header of the new list at the end of the store. The length
+    // is filled in when the list is finished.
+    list_record_pos = list_used;
+    if (list_used > LIST_STORE_SIZE - 2)
+        return 0;
+    list_store [list_used++] = id;
+    list_store [list_used++] = 0;
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Finish the list at list_record_pos by filling in the length. An EEPROM
+/// list is moved out of the RAM store into its EEPROM slot.
+///
+/// @param [in] length The length of the list in bytes.
+///
+static void
+list_finish (uint8_t length)
+{
+    uint8_t *ptr;
+
+    ptr = &list_store [list_record_pos];
+    ptr[1] = length;
+    list_used = list_record_pos + 2 + length;
+
+#if EEPROM_LIST_NUM > 0
+    // Move an EEPROM list out of the RAM store into its EEPROM slot.
+    if (ptr[0] & LIST_EEPROM)
+    {
+        uint8_t *eeprom_addr;
+        uint8_t slot;
+
+        slot = ptr[0] & ~LIST_EEPROM;
+        if ((slot < EEPROM_LIST_NUM) && (length < EEPROM_LIST_SIZE))
+        {
+            eeprom_addr = (uint8_t *)(((int)(slot) * EEPROM_LIST_SIZE) + EEPROM_ADDR_LIST_START);
+            ptr++;
+            do
+            {
+                eeprom_write_byte (eeprom_addr++, *ptr++);
+            }
+            while (length-- > 0);
+        }
+        list_used = list_record_pos;
+    }
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Start recording a display list. Any existing list with the same identity
+/// is deleted. The commands that follow are executed as normal and are also
+/// captured into the list until CMDX_LIST_END is received.
+///
+/// @param [in] id The identity of the list. When the top bit is set, and
+///                the device has the room, the list is stored in EEPROM.
+///
+void
+list_begin (uint8_t id)
+{
+    // Lists may only be managed from the serial port.
+    if (list_depth != 0)
+        return;
+
+    // Abandon any list that is part way through recording.
+    if (list_recording != LIST_RECORD_OFF)
+        list_used = list_record_pos;
+
+    if (list_new (id))
+        list_recording = LIST_RECORD_ON;
+    else
+        list_recording = LIST_RECORD_OVERFLOW;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Record a byte received from the serial port into the list that is being
+/// recorded. A LIST_ESCAPE is recorded twice so that it is not mistaken
+/// for an argument on replay.
+///
+/// @param [in] cc The byte to record.
+///
+void
+list_record (uint8_t cc)
+{
+    uint8_t count = (cc == LIST_ESCAPE) ? 2 : 1;
+
+    while ((count-- > 0) && (list_recording == LIST_RECORD_ON))
+    {
+        // Make sure that there is room for the byte and that the length
+        // still fits in the header.
+        if ((list_used < LIST_STORE_SIZE) &&
+            (list_used - list_record_pos < 255 + 2))
+            list_store [list_used++] = cc;
+        else
+            list_recording = LIST_RECORD_OVERFLOW;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Finish recording a display list. The bytes of the CMDX_LIST_END command
+/// itself have been recorded and are removed from the list. A list that
+/// did not fit in the store is discarded.
+///
+void
+list_end (void)
+{
+    int16_t length;
+
+    // Lists may only be managed from the serial port.
+    if ((list_depth != 0) || (list_recording == LIST_RECORD_OFF))
+        return;
+
+    // Strip the command; in text mode this is preceded by a CHAR_COMMAND.
+    length = list_used - list_record_pos - 2;
+    if (is_graphics())
+        length -= 1;
+    else
+        length -= 2;
+
+    // Discard an empty list or a list that overflowed.
+    if ((list_recording == LIST_RECORD_OVERFLOW) || (length <= 0))
+        list_used = list_record_pos;
+    else
+        list_finish (length);
+    list_recording = LIST_RECORD_OFF;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Define a display list from the serial port without executing it. The
+/// bytes are stored as they are received so the host may place argument
+/// escapes in the list to create a template.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] length The number of bytes in the list that follow.
+///
+void
+list_define (uint8_t id, uint8_t length)
+{
+    uint8_t count;
+
+    // Lists may only be managed from the serial port, when this is not the
+    // case or there is not room then the definition is discarded.
+    count = 0;
+    if ((list_depth == 0) && (list_recording == LIST_RECORD_OFF) &&
+        list_new (id))
+        count = length;
+
+    while (length-- > 0)
+    {
+        uint8_t cc = serial_getc ();
+
+        if (count != 0)
+        {
+            if (list_used < LIST_STORE_SIZE)
+                list_store [list_used++] = cc;
+            else
+                count = 0;
+        }
+    }
+
+    // A trailing escape has no argument number to follow it and would take
+    // replay past the end of the list, so it is dropped.
+    if (count != 0)
+    {
+        uint16_t pos;
+
+        for (pos = list_record_pos + 2; pos < list_used; pos++)
+        {
+            if (list_store [pos] == LIST_ESCAPE)
+                pos++;
+        }
+        if (pos > list_used)
+            count--;
+    }
+
+    // Complete the list or throw away the part that did not fit.
+    if (count != 0)
+        list_finish (count);
+    else
+        list_used = list_record_pos;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Push a display list onto the replay stack.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] count The number of times to replay the list.
+///
+static void
+list_push (uint8_t id, uint8_t count)
+{
+    uint16_t pos;
+    uint8_t length;
+
+    // Make sure that there is room on the stack.
+    if (list_depth >= LIST_DEPTH)
+        return;
+
+#if EEPROM_LIST_NUM > 0
+    if (id & LIST_EEPROM)
+    {
+        id &= ~LIST_EEPROM;
+        if (id >= EEPROM_LIST_NUM)
+            return;
+
+        // Locate the list in EEPROM. An erased slot reads as 0xff.
+        pos = ((int)(id) * EEPROM_LIST_SIZE) + EEPROM_ADDR_LIST_START;
+        length = eeprom_read_byte ((const uint8_t *)(pos));
+        if (length >= EEPROM_LIST_SIZE)
+            return;
+        pos = (pos + 1) | LIST_POS_EEPROM;
+    }
+    else
+#endif
+    {
+        uint8_t *ptr;
+
+        // Locate the list in RAM.
+        if ((ptr = list_find (id)) == NULL)
+            return;
+        length = ptr[1];
+        pos = (ptr - list_store) + 2;
+    }
+
+    // Push the list onto the replay stack.
+    if ((length > 0) && (count > 0))
+    {
+        list_frame [list_depth].pos = pos;
+        list_frame [list_depth].start = pos;
+        list_frame [list_depth].end = pos + length;
+        list_frame [list_depth].count = count;
+        list_depth++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Replay a display list. The bytes of the list are returned by
+/// serial_getc() ahead of any bytes in the serial buffer. Lists may call
+/// other lists up to a depth of LIST_DEPTH, calls that are deeper than
+/// this are ignored.
+///
+/// @param [in] id The identity of the list.
+///
+void
+list_call (uint8_t id)
+{
+    list_push (id, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Read the template arguments from the serial port. Arguments beyond
+/// LIST_ARGS are discarded.
+///
+/// @param [in] argc The number of arguments.
+/// @param [out] args Where to store the arguments.
+///
+static void
+list_get_args (uint8_t argc, uint8_t *args)
+{
+    uint8_t ii;
+
+    for (ii = 0; ii < argc; ii++)
+    {
+        uint8_t cc = serial_getc ();
+
+        if (ii < LIST_ARGS)
+            args [ii] = cc;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Replay a display list template with arguments. The arguments follow the
+/// command on the serial port.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] argc The number of arguments that follow.
+///
+void
+list_exec (uint8_t id, uint8_t argc)
+{
+    list_get_args (argc, list_args);
+    list_push (id, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Replay a display list template a number of times. The arguments follow
+/// the command on the serial port and are then followed by a signed step
+/// for each argument which is added to the argument after each replay.
+///
+/// @param [in] id The identity of the list.
+/// @param [in] count The number of times to replay the list.
+/// @param [in] argc The number of arguments and steps that follow.
+///
+void
+list_repeat (uint8_t id, uint8_t count, uint8_t argc)
+{
+    list_get_args (argc, list_args);
+    memset (list_steps, 0, sizeof (list_steps));
+    list_get_args (argc, (uint8_t *)(list_steps));
+    list_push (id, count);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Get the next byte from the display list that is being replayed. Only
+/// valid when list_depth is non-zero.
+///
+/// @return The next byte of the list.
+///
+uint8_t
+list_getc (void)
+{
+    uint8_t cc;
+
+    cc = list_next (&list_frame [list_depth - 1].pos);
+
+    // Restart a list that is being repeated and pop any lists that have
+    // finished so that the next byte comes from the caller, or the serial
+    // port.
+    while (list_depth > 0)
+    {
+        uint8_t depth = list_depth - 1;
+
+        if (list_frame [depth].pos < list_frame [depth].end)
+            break;
+        if (--list_frame [depth].count != 0)
+        {
+            uint8_t ii;
+
+            list_frame [depth].pos = list_frame [depth].start;
+            for (ii = 0; ii < LIST_ARGS; ii++)
+                list_args [ii] += list_steps [ii];
+            break;
+        }
+        list_depth = depth;
+    }
+
+    return cc;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Peek ahead into the display lists that are being replayed. The peek
+/// does not look past the end of a repeated list into its next repeat.
+///
+/// @param [in,out] offset The offset from the read position. On return,
+///                        when the offset is beyond the end of the lists,
+///                        this is the offset into the serial buffer.
+///
+/// @return The byte at the offset or -1 if the offset is beyond the end of
+///         the lists.
+///
+int16_t
+list_peek (uint16_t *offset)
+{
+    uint8_t depth = list_depth;
+
+    while (depth > 0)
+    {
+        uint16_t pos;
+
+        depth--;
+        pos = list_frame [depth].pos;
+        while (pos < list_frame [depth].end)
+        {
+            uint8_t cc = list_next (&pos);
+
+            if (*offset == 0)
+                return cc;
+            (*offset)--;
+        }
+    }
+    return -1;
+}
+
+#endif /* DISPLAY_LIST */
@@ -296,9 +296,14 @@ main (void)
     // Initialise the fonts.
     font_set (prefs_font, CMDX_FONT_SET);
     font_mode (MODE_NORMAL);
+    font_window_init ();
 
     // Set the drawing modes to an initialised state of normal
     drawing_mode = MODE_NORMAL;
+#ifdef DRAW_SCALE
+    draw_scale (1);
+#endif
+    draw_clip (0, 0, 0xff, 0xff);       // Draw on the whole screen.
 
     // Set the baud rate to the user preference
     prefs_baudrate = serial_baudrate (prefs_baudrate);
@@ -374,7 +379,7 @@ next_command:
                 }
 
                 // Otherwise draw the character
-                font_draw (cc);
+                font_draw_run (cc);
             }
         }
 
@@ -405,7 +410,7 @@ graphics_command:
 #define argc hi                         /* Re-use the variable */
 #define argf lo                         /* Re-use the variable */
                         void *func = pgm_read_word(&cmd_functabP[pgm_read_byte (&cmdtable_funcsP[mid])]);
-                        uint8_t argv[6];
+                        uint8_t argv[7];
 
                         argf = pgm_read_byte (&cmdtable_argsP[mid]);
                         argc = 0;
@@ -476,8 +481,11 @@ graphics_command:
                             }
                             else
                             {
-                                // 6 arguments.
-                                ((vfunc_iiiiii_t) func)(argv[0], argv[1], argv[2], argv[3], argv[4], argv[5]);
+                                // 6 or 7 arguments.
+                                if (argc == 6)
+                                    ((vfunc_iiiiii_t) func)(argv[0], argv[1], argv[2], argv[3], argv[4], argv[5]);
+                                else
+                                    ((vfunc_iiiiiii_t) func)(argv[0], argv[1], argv[2], argv[3], argv[4], argv[5], argv[6]);
                             }
                         }
 
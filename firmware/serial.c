@@ -174,6 +174,24 @@ serial_flush (void)
     serial_putc (CHAR_XON);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+///
+/// Get the number of characters that may be read from the RX_buffer without
+/// blocking. No characters are reported while a display list is being
+/// replayed, the list is read one character at a time.
+///
+/// @return The number of characters that have been received.
+///
+uint8_t
+serial_ready (void)
+{
+#ifdef DISPLAY_LIST
+    if (list_depth != 0)
+        return 0;
+#endif
+    return rx_count;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 ///
 /// Peek into the RX_buffer and retrieve a character from the RX_buffer before
@@ -188,6 +206,18 @@ serial_flush (void)
 char
 serial_peek (uint16_t offset)
 {
+    // Look into any display list that is being replayed first, the bytes
+    // beyond the end of the lists are in the RX_buffer.
+#ifdef DISPLAY_LIST
+    if (list_depth != 0)
+    {
+        int16_t cc;
+
+        if ((cc = list_peek (&offset)) >= 0)
+            return cc;
+    }
+#endif
+
     // Wait for the the character to enter the RX_buffer.
     while (rx_count <= offset)
     {
@@ -232,9 +262,21 @@ serial_getc (void)
 {
     char cc;
 
+    // A display list that is being replayed is read ahead of the RX_buffer.
+#ifdef DISPLAY_LIST
+    if (list_depth != 0)
+    {
+        // Reset the watchdog so it does not fire
+        wdt_reset();
+        return list_getc ();
+    }
+#endif
+
     // Wait for data to be available
     while (rx_count == 0)
     {
+        // Bring the display up to date while there is nothing to do.
+        ks0108b_flush ();
         // Reset the watchdog so it does not fire
         wdt_reset(); 
     }
@@ -266,6 +308,12 @@ serial_getc (void)
         }
     }
 
+#ifdef DISPLAY_LIST
+    // Capture the character if a display list is being recorded.
+    if (list_recording != LIST_RECORD_OFF)
+        list_record (cc);
+#endif
+
     // Reset the watchdog so it does not fire
     wdt_reset(); 
     
@@ -284,6 +332,19 @@ serial_getc (void)
 uint8_t 
 serial_flushc (uint8_t bytes)
 {
+    // When a display list is being replayed or recorded then the bytes must
+    // pass through serial_getc().
+#ifdef DISPLAY_LIST
+    if ((list_depth | list_recording) != 0)
+    {
+        uint8_t count;
+
+        for (count = bytes; count > 0; count--)
+            serial_getc ();
+        return bytes;
+    }
+#endif
+
     // Interrupts must be disabled when changing rx_count, since it can be
     // changed here and in the ISR. 
     cli();
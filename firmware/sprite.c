@@ -52,6 +52,10 @@
 // them, but default I set these to 34 and 8 for a total of 272 bytes. this
 // is sufficient for 8 16x16 sprites. These can be changed, but watch the
 // total memory used. There is only 1k total on the ATmega168.
+//
+// On the 160x128 display, when built with T6963_STORE, the sprite identities
+// with VRAM_SPRITE set are held in the spare display memory by the driver,
+// these may be of any size up to the size of the screen.
 
 // Sprite is an array to hold sprites, each is SPRITE_BYTES long, each sprite
 // has [width],[height],[bunch O' bytes for bitblk] user must make sure data
@@ -67,7 +71,8 @@ sprite [SPRITE_SIZE * NUM_SPRITES];
 /// @param [in] x is the first x-coordinate to start drawing.
 /// @param [in] y is the first y-coordinate to start drawing.
 /// @param [in] sprite_id identifies the sprite to draw.
-/// @param [in] s_r The drawing mask.
+/// @param [in] s_r The drawing mask. A sprite that is not in VRAM is drawn
+///                 at the drawing scale.
 ///
 void
 sprite_draw (uint8_t x, uint8_t y, uint8_t sprite_id, uint8_t mode)
@@ -112,6 +117,16 @@ sprite_draw (uint8_t x, uint8_t y, uint8_t sprite_id, uint8_t mode)
         // Point at the start of the buffer.
         sprite_ptr = &draw_buffer [offset];
     }
+#ifdef T6963_STORE
+    else if ((sprite_id & VRAM_SPRITE) && is_large())
+    {
+        // VRAM based sprite, the driver draws directly from display memory
+        // so the origin is applied here.
+        if (draw_at_origin (&x, &y))
+            t6963_sprite_draw (x, y, sprite_id & ~VRAM_SPRITE, mode);
+        return;
+    }
+#endif
     else
     {
         // Ensure that the sprite_id is valid
@@ -126,11 +141,11 @@ sprite_draw (uint8_t x, uint8_t y, uint8_t sprite_id, uint8_t mode)
     if (mode & MODE_SPRITE_CENTER)
     {
         // Centre the sprite at x,y by adjusting the x,y coordinates.
-        width = (*sprite_ptr++) >> 1;   // Get the width/2
+        width = ((uint16_t)(*sprite_ptr++) * drawing_scale) >> 1; // Get the width/2
         if (x > width)
             x -= width;
 
-        height = (*sprite_ptr--) >> 1;  // Get the height/2
+        height = ((uint16_t)(*sprite_ptr--) * drawing_scale) >> 1; // Get the height/2
         if (y > height)
             y -= height;
 
@@ -185,6 +200,13 @@ sprite_upload (uint8_t sprite_id, uint8_t width, uint8_t height)
             while (--sprite_bytes > 0);
         }
     }
+#ifdef T6963_STORE
+    else if ((sprite_id & VRAM_SPRITE) && is_large())
+    {
+        // This is a VRAM based sprite.
+        t6963_sprite_upload (sprite_id & ~VRAM_SPRITE, width, height);
+    }
+#endif
     else
     {
         // This is a RAM based sprite.
@@ -48,6 +48,41 @@
  * completely re-designed to deal with the pixels organised as rows rather
  * than columns.
  *
+ * The graphic area is not fixed in display memory. The graphic home address
+ * moves through a ring of VRAM twice the size of the screen so that a
+ * vertical scroll only changes the home address and clears the band of lines
+ * that scrolls onto the screen. The set_pointer() and set_column_pointer()
+ * functions add the home address and wrap within the ring. When the home
+ * address reaches the end of the ring then the visible part of the screen is
+ * copied back to the other end of the ring; this happens once every screen
+ * height of scrolling.
+ *
+ * In page mode the ring holds two screen pages. The displayed page and the
+ * page that is drawn on are separate; drawing goes to the back page and a
+ * page flip swaps them by changing the graphic home address. Scrolling in
+ * page mode copies the back page as it is not visible.
+ *
+ * The display memory above the graphic ring is not displayed and, when
+ * built with T6963_STORE, is used as a store for sprites and saved areas of
+ * the screen. The store starts with a directory of handles, each holding
+ * the address and length of a block, followed by a heap of blocks. Blocks
+ * are allocated from the top of the heap; when the heap is full the live
+ * blocks are moved down over any released blocks.
+ *
+ * The hardware text layer is built with T6963_TEXT_LAYER and uses the top
+ * 2K of display memory, the store is limited to the memory below it while
+ * the text layer is enabled. The
+ * characters are held in external CG RAM at the start of the 2K, as the
+ * character code less 0x20, followed by the text area and the attribute
+ * area. In attribute mode the graphic home register points at the attribute
+ * area and the graphics are not displayed although they continue to be
+ * drawn.
+ *
+ * The controller address pointer is shadowed so that set_address() only
+ * loads the pointer when it has to. The shadow follows the auto read and
+ * write modes; a move to an adjacent address is made with a single
+ * incrementing or decrementing read.
+ *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
  * to deal in the Software without restriction, including without limitation
@@ -80,6 +115,22 @@
 #define SCREEN_WIDTH   160               /* Screen width */
 #define SCREEN_HEIGHT  128               /* Screen height */
 #define SCREEN_COLUMNS (SCREEN_WIDTH/8)  /* Screen columns */
+#define SCREEN_SIZE    (SCREEN_COLUMNS*SCREEN_HEIGHT) /* Bytes in screen */
+
+/* Define the display memory layout */
+#define VRAM_SIZE      0x2000            /* Size of display memory */
+#define GRAPHIC_RING   (2*SCREEN_SIZE)   /* Ring the graphic home moves in */
+#define STORE_SLOT     VRAM_SPRITE_NUM   /* Handle of the first screen slot */
+#define STORE_HANDLES  (STORE_SLOT + SCREEN_SLOT_NUM) /* Handles in the store */
+#define STORE_ENTRY    4                 /* Bytes in a directory entry */
+#define STORE_HEAP     (GRAPHIC_RING + (STORE_HANDLES * STORE_ENTRY))
+#define TEXT_CG        0x1800            /* CG RAM of the text layer */
+#define TEXT_OFFSET    (TEXT_CG >> 11)   /* The offset register of TEXT_CG */
+#define TEXT_COLUMNS   SCREEN_COLUMNS    /* Text columns of 8 pixels */
+#define TEXT_ROWS      (SCREEN_HEIGHT/8) /* Text rows of 8 pixels */
+#define TEXT_SIZE      (TEXT_COLUMNS*TEXT_ROWS) /* Bytes in text area */
+#define TEXT_HOME      (TEXT_CG + (96 * 8)) /* Text area after 96 characters */
+#define TEXT_ATTR      (TEXT_HOME + TEXT_SIZE) /* Text attribute area */
 
 // Pins for the t6963 (160x128) display
 #define WR      0       /* PC0 */
@@ -143,9 +194,42 @@
 #define CMD_SCREEN_COPY            DEFCMD(STA01, 0xe8)  /* Screen copy */
 #define CMD_BIT_SET_RESET          DEFCMD(STA01, 0xf0)  /* Bit set/reset */
 
+/* Text attributes */
+#define TEXT_ATTR_REVERSE          0x05  /* Reverse display */
+#define TEXT_ATTR_BLINK            0x08  /* Blink */
+
 // The next status check value
 static uint8_t status_value = STA01;
 
+// The value of the controller address pointer, ADDRESS_UNKNOWN when it is not
+// known. The unknown value is outside of display memory so that it is never
+// adjacent to a valid address.
+#define ADDRESS_UNKNOWN 0x8000
+static uint16_t address_pointer;
+
+// The graphic home address; the address of the top left of the screen.
+static uint16_t graphic_home;
+
+// The address of the top left of the page that is drawn on. This is the
+// same as the graphic home address except in page mode.
+static uint16_t draw_home;
+
+// Page mode; when set drawing is performed on the back page.
+static uint8_t page_mode;
+
+#ifdef T6963_STORE
+// The top of the store heap; the address of the first free byte.
+static uint16_t store_top;
+
+// The end of the store heap; the text layer takes the memory above it.
+static uint16_t store_end;
+#endif
+
+#ifdef T6963_TEXT_LAYER
+// The text layer flags, zero when the text layer is off.
+static uint8_t text_layer;
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 /// Perform a STA1 status check. This blocks until the status is set by the
 /// controller.
@@ -201,8 +285,10 @@ data_write (uint8_t data)
     PORTC &= ~((1 << CD) |              // Data command
                (1 << WR) | (1 << CE));  // Write + Chip enable
 
-    // We need a minimum 80ns delay here.
-    asm volatile ("nop");
+    // We need a minimum 80ns delay here. In auto mode the address pointer
+    // moves on after each write.
+    if (status_value != STA01)
+        address_pointer++;
     asm volatile ("nop");
 
     PORTC |= ((1 << WR) | (1 << CE) |   // Deselect the chip
@@ -239,6 +325,10 @@ data_read (void)
     PORTC |= ((1 << CE) | (1 << RD) |   // Deselect the chip.
               (1 << CD));
 
+    // In auto mode the address pointer moves on after each read.
+    if (status_value != STA01)
+        address_pointer++;
+
     // Return the data to the caller.
     return data;
 }
@@ -285,30 +375,41 @@ cmd_write (uint16_t command)
 }
 
 /////////////////////////////////////////////////////////////////////////////
-/// Set the pointer to the byte which contains an arbirary x, y point. For
-/// our 160 x 128 pixel display, there are 20*128 memory address, so we need
-/// a 16-bit value address to refer to the whole graphics area array.
+/// Set the address pointer to an address in display memory.
+///
+/// @param [in] address The display memory address.
+///
 static void
-set_pointer (uint8_t x, uint8_t y)
+set_address (uint16_t address)
 {
-    uint16_t address;
-
-    // Calculate which address in our memory space contains the pixel. For
-    // each increase in y, we increase by 20 locations. For each 8 pixels in
-    // x, we increase by one location. Using a 3-right-shift is a cheap way
-    // of doing divide by 8 in a processor without a divide operation. Maybe
-    // the compiler knows that, maybe not.
-    address = (y * SCREEN_COLUMNS) + (x >> 3);
+    // Nothing to do if the controller is already at the address.
+    if (address == address_pointer)
+        return;
 
-    // Now that we have our address, we can write our data out. This is the
-    // low byte of the address
-    data_write ((uint8_t)(address & 0xff));
+    // An adjacent address is reached with a read that moves the pointer,
+    // this is one command rather than a command with two bytes of data.
+    if (address == address_pointer + 1)
+    {
+        cmd_write (CMD_DATA_READ_INC);
+        data_read ();
+    }
+    else if (address == address_pointer - 1)
+    {
+        cmd_write (CMD_DATA_READ_DEC);
+        data_read ();
+    }
+    else
+    {
+        // This is the low byte of the address
+        data_write ((uint8_t)(address & 0xff));
 
-    // This is the high byte of the address
-    data_write ((uint8_t)(address >> 8));
+        // This is the high byte of the address
+        data_write ((uint8_t)(address >> 8));
 
-    // This is the command for "set pointer address".
-    cmd_write (CMD_SET_ADDR_POINTER);
+        // This is the command for "set pointer address".
+        cmd_write (CMD_SET_ADDR_POINTER);
+    }
+    address_pointer = address;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -325,18 +426,187 @@ set_column_pointer (uint8_t x_column, uint8_t y)
     // x, we increase by one location. Using a 3-right-shift is a cheap way
     // of doing divide by 8 in a processor without a divide operation. Maybe
     // the compiler knows that, maybe not.
-    address = (y * SCREEN_COLUMNS) + x_column;
+    address = draw_home + (y * SCREEN_COLUMNS) + x_column;
 
-    // Now that we have our address, we can write our data out. This is the
-    // low byte of the address
-    data_write ((uint8_t)(address & 0xff));
+    // Wrap within the graphic ring, this only happens for positions off the
+    // bottom of the screen.
+    if (address >= GRAPHIC_RING)
+        address -= GRAPHIC_RING;
+
+    // Now that we have our address, we can write our data out.
+    set_address (address);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Set the pointer to the byte which contains an arbirary x, y point. For
+/// our 160 x 128 pixel display, there are 20*128 memory address, so we need
+/// a 16-bit value address to refer to the whole graphics area array.
+static void
+set_pointer (uint8_t x, uint8_t y)
+{
+    // Convert the x position to a column.
+    set_column_pointer (x >> 3, y);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Set the graphic home address, this is the address of the top left of the
+/// screen.
+///
+/// @param [in] address The display memory address.
+///
+static void
+set_graphic_home (uint16_t address)
+{
+    // Outside of page mode we draw on the page that is displayed.
+    graphic_home = address;
+    if (page_mode == 0)
+        draw_home = address;
+
+#ifdef T6963_TEXT_LAYER
+    // In text attribute mode the graphic home holds the attributes.
+    if ((text_layer & TEXT_LAYER_ATTRIBUTE) != 0)
+        address = TEXT_ATTR;
+#endif
 
-    // This is the high byte of the address
+    // Write the low and high bytes of the graphics home address.
+    data_write ((uint8_t)(address & 0xff));
     data_write ((uint8_t)(address >> 8));
 
-    // This is the command for "set pointer address".
-    cmd_write (CMD_SET_ADDR_POINTER);
+    // "Write graphics home address" command.
+    cmd_write (CMD_SET_GRAPIC_HOME_ADDR);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Copy a block of display memory. The source and destination may overlap.
+///
+/// @param [in] src The source address.
+/// @param [in] dst The destination address.
+/// @param [in] length The number of bytes to copy.
+/// @param [in] buf A buffer of SCREEN_WIDTH bytes to copy through.
+///
+static void
+copy_block (uint16_t src, uint16_t dst, uint16_t length, uint8_t *buf)
+{
+    int16_t step;                       // The step between chunks.
+
+    // Copy from the end when moving up memory so that the source is read
+    // before it is over written.
+    step = SCREEN_WIDTH;
+    if ((dst > src) && (dst < src + length))
+    {
+        step = -SCREEN_WIDTH;
+        src += length;
+        dst += length;
+    }
+
+    while (length > 0)
+    {
+        uint8_t num_bytes;              // The number of bytes to copy
+        uint8_t xx;
+
+        num_bytes = (length > SCREEN_WIDTH) ? SCREEN_WIDTH : length;
+        if (step < 0)
+        {
+            src -= num_bytes;
+            dst -= num_bytes;
+        }
+
+        // Read in the source.
+        set_address (src);
+        cmd_write (CMD_DATA_AUTO_READ);
+        for (xx = 0; xx < num_bytes; xx++)
+            buf[xx] = data_read ();
+        cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+
+        // Write out to the destination.
+        set_address (dst);
+        cmd_write (CMD_DATA_AUTO_WRITE);
+        for (xx = 0; xx < num_bytes; xx++)
+            data_write (buf[xx]);
+        cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+
+        if (step > 0)
+        {
+            src += num_bytes;
+            dst += num_bytes;
+        }
+        length -= num_bytes;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Fill a block of display memory.
+///
+/// @param [in] address The address of the block.
+/// @param [in] length The number of bytes to fill.
+/// @param [in] data The value to fill with.
+///
+static void
+fill_block (uint16_t address, uint16_t length, uint8_t data)
+{
+    set_address (address);
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    while (length-- > 0)
+        data_write (data);
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+}
+
+#ifdef T6963_TEXT_LAYER
+/////////////////////////////////////////////////////////////////////////////
+/// Clear the text layer.
+///
+/// @param [in] mode The current mode, the attributes are reversed when the
+///                  mode is MODE_REVERSE.
+///
+static void
+text_clear (uint8_t mode)
+{
+    // The space character is code zero.
+    fill_block (TEXT_HOME, TEXT_SIZE, 0);
+    fill_block (TEXT_ATTR, TEXT_SIZE,
+                ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? TEXT_ATTR_REVERSE : 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Scroll the text layer vertically by whole rows.
+///
+/// @param [in] buf A buffer of SCREEN_WIDTH bytes to copy through.
+/// @param [in] rows The number of rows to scroll where -ve is up.
+/// @param [in] mode The current mode.
+///
+static void
+text_scroll (uint8_t *buf, int8_t rows, uint8_t mode)
+{
+    uint16_t area;                      // The area being scrolled.
+    uint16_t length;                    // The number of bytes scrolled.
+    uint16_t first;                     // The offset of the first cleared.
+    uint8_t data;                       // The value of the cleared cells.
+
+    // The attribute of the cleared cells follows the mode.
+    data = ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? TEXT_ATTR_REVERSE : 0;
+
+    // Scroll the text and then the attribute area.
+    for (area = TEXT_HOME; /* Forever */; area = TEXT_ATTR)
+    {
+        if (rows < 0)
+        {
+            length = (uint8_t)(-rows) * TEXT_COLUMNS;
+            first = TEXT_SIZE - length;
+            copy_block (area + length, area, first, buf);
+        }
+        else
+        {
+            length = rows * TEXT_COLUMNS;
+            first = 0;
+            copy_block (area, area + length, TEXT_SIZE - length, buf);
+        }
+        fill_block (area + first, length, (area == TEXT_HOME) ? 0 : data);
+
+        if (area == TEXT_ATTR)
+            break;
+    }
 }
+#endif /* T6963_TEXT_LAYER */
 
 /////////////////////////////////////////////////////////////////////////////
 /// Clearing the display. All we're *really* doing is writing a one or zero
@@ -355,6 +625,11 @@ t6963_screen_clear (uint8_t mode)
     // 0x00 when reversed we write 0xff. Note: 0x00-0x01 = 0xff !!
     data = (mode & MODE_NORMAL_MASK) - 1;
 
+    // Move the screen back to the start of the graphic ring. In page mode
+    // the pages stay where they are and only the back page is cleared.
+    if ((graphic_home != 0) && (page_mode == 0))
+        set_graphic_home (0);
+
     // Start from the top of memory.
     set_pointer (0,0);
 
@@ -365,10 +640,18 @@ t6963_screen_clear (uint8_t mode)
     for (ii = 0; ii < (SCREEN_COLUMNS * SCREEN_HEIGHT); ii++)
         data_write (data);
     cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+
+#ifdef T6963_TEXT_LAYER
+    // Clear the text layer.
+    if (text_layer != 0)
+        text_clear (mode);
+#endif
 }
 
 /////////////////////////////////////////////////////////////////////////////
-/// Scroll the display up by 1 character line.
+/// Scroll the display vertically. The graphic home address is moved so the
+/// screen contents are not copied, only the band of lines that scrolls onto
+/// the screen is cleared.
 ///
 /// @param [in] buf The buffer to use for reading and writing
 /// @param [in] pixels The number of pixels to scroll where -ve is up
@@ -377,47 +660,90 @@ t6963_screen_clear (uint8_t mode)
 void
 t6963_vscroll (uint8_t *buf, int8_t pixels, uint8_t mode)
 {
-    uint8_t yy;                         // The y coordinate.
-    
-    // TODO: Currently we ignore pixels and simple do -8.
-    
+    uint16_t address;                   // The new graphic home address.
+    uint16_t length;                    // The number of bytes scrolled.
+    uint8_t first;                      // The first line to clear.
+
+    // Nothing to do, or the whole screen scrolls off. The screen is as
+    // high as the range of pixels so this is only possible scrolling up.
+    if (pixels == 0)
+        return;
+    if (pixels == -SCREEN_HEIGHT)
+    {
+        t6963_screen_clear (mode);
+        return;
+    }
+
     // Determine if the screen is reversed or not. In normal mode we write
     // 0x00 when reversed we write 0xff. Note: 0x00-0x01 = 0xff !!
     mode = (mode & MODE_NORMAL_MASK) - 1;
-    
-    // Iterate over the whole screen.
-    for (yy = 0; yy < SCREEN_HEIGHT; yy += 8)
+
+    if (page_mode != 0)
     {
-        uint8_t xx;
-        
-        // If we are at the last line then fill with the background colour 
-        if (yy == (SCREEN_HEIGHT - 8))
+        // The back page is not displayed so simply copy the lines that
+        // stay on the page.
+        address = graphic_home;
+        if (pixels < 0)
         {
-            memset (buf, mode, SCREEN_WIDTH);
+            first = SCREEN_HEIGHT + pixels;
+            length = (uint8_t)(-pixels) * SCREEN_COLUMNS;
+            copy_block (draw_home + length, draw_home, SCREEN_SIZE - length, buf);
         }
         else
         {
-            // Reset our position to the start of the row.
-            set_pointer (0, yy + 8);
-
-            // Read in the existing lines.
-            
-            // Iterate over a block of data
-            cmd_write (CMD_DATA_AUTO_READ);
-            for (xx = 0; xx < SCREEN_WIDTH; xx++)
-                buf[xx] = data_read ();
-            cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+            first = 0;
+            length = pixels * SCREEN_COLUMNS;
+            copy_block (draw_home, draw_home + length, SCREEN_SIZE - length, buf);
         }
-        
-        // Reset our position to the start of the row.
-        set_pointer (0, yy);
+    }
+    else if (pixels < 0)
+    {
+        // Scroll up, the screen moves down the ring.
+        first = SCREEN_HEIGHT + pixels;
+        length = (uint8_t)(-pixels) * SCREEN_COLUMNS;
+        address = graphic_home + length;
+
+        // If the screen runs off the end of the ring then move the lines that
+        // stay on the screen to the start of the ring.
+        if (address > GRAPHIC_RING - SCREEN_SIZE)
+        {
+            copy_block (address, 0, SCREEN_SIZE - length, buf);
+            address = 0;
+        }
+    }
+    else
+    {
+        // Scroll down, the screen moves up the ring.
+        first = 0;
+        length = pixels * SCREEN_COLUMNS;
 
-        // Write the reversed lines.
-        cmd_write (CMD_DATA_AUTO_WRITE);
-        for (xx = 0; xx < SCREEN_WIDTH; xx++)
-            data_write (buf[xx]);
-        cmd_write (CMD_DATA_AUTO_RESET); // End of auto mode.
+        // If the screen runs off the start of the ring then move the lines
+        // that stay on the screen to the end of the ring.
+        if (graphic_home < length)
+        {
+            address = GRAPHIC_RING - SCREEN_SIZE;
+            copy_block (graphic_home, address + length, SCREEN_SIZE - length, buf);
+        }
+        else
+            address = graphic_home - length;
     }
+
+    // Display the new screen position.
+    if (address != graphic_home)
+        set_graphic_home (address);
+
+    // Clear the band of lines that has scrolled onto the screen.
+    set_pointer (0, first);
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    while (length-- > 0)
+        data_write (mode);
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+
+#ifdef T6963_TEXT_LAYER
+    // Scroll the text layer by the whole rows.
+    if ((text_layer != 0) && ((pixels /= 8) != 0))
+        text_scroll (buf, pixels, (uint8_t)(mode + 1));
+#endif
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -458,6 +784,70 @@ t6963_screen_reverse (uint8_t *buf)
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Enable or disable page mode. In page mode the displayed screen is moved to
+/// the first page and copied to the back page; drawing is then performed on
+/// the back page until the pages are flipped.
+///
+/// @param [in] enable Non-zero to enable page mode, zero to draw on the
+///                    displayed page again.
+///
+void
+t6963_page_mode (uint8_t enable)
+{
+    // Only the T6963 has the display memory for pages.
+    if (!is_large())
+        return;
+
+    if (enable == 0)
+    {
+        // Draw on the displayed page, this remains a valid position in the
+        // graphic ring.
+        page_mode = 0;
+        draw_home = graphic_home;
+    }
+    else if (page_mode == 0)
+    {
+        // Move the displayed screen to the first page.
+        if (graphic_home != 0)
+        {
+            copy_block (graphic_home, 0, SCREEN_SIZE, draw_buffer);
+            set_graphic_home (0);
+        }
+
+        // Start the back page as a copy of the displayed page.
+        page_mode = 1;
+        draw_home = SCREEN_SIZE;
+        copy_block (0, SCREEN_SIZE, SCREEN_SIZE, draw_buffer);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Flip the pages in page mode. The back page is displayed and the page that
+/// was displayed becomes the back page.
+///
+/// @param [in] flags PAGE_FLIP_COPY to copy the newly displayed page to the
+///                   back page so that drawing may continue incrementally.
+///
+void
+t6963_page_flip (uint8_t flags)
+{
+    uint16_t address;                   // The new graphic home address.
+
+    // Ignore a flip when not in page mode.
+    if (page_mode == 0)
+        return;
+
+    // Swap the pages.
+    address = draw_home;
+    draw_home = graphic_home;
+    set_graphic_home (address);
+
+    // Bring the back page up to date.
+    if ((flags & PAGE_FLIP_COPY) != 0)
+        copy_block (graphic_home, draw_home, SCREEN_SIZE, draw_buffer);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 /// First unitialisation of the device. Set up the display hardware.
 ///
@@ -472,15 +862,26 @@ t6963_init (void)
     x_dim = SCREEN_WIDTH;
     y_dim = SCREEN_HEIGHT;
 
+    // The controller address pointer is not known after a reset.
+    address_pointer = ADDRESS_UNKNOWN;
+#ifdef T6963_TEXT_LAYER
+    text_layer = 0;
+#endif
+
     // The first part of display initialization is to set the start location
     // of the graphics in memory. We'll set it to 0x0000.
+    page_mode = 0;
+    set_graphic_home (0);
 
-    // Write the low byte of the graphics home address.
-    data_write (0x00);
-    // Write the high byte of the graphics home address.
-    data_write (0x00);
-    // "Write graphics home address" command.
-    cmd_write (CMD_SET_GRAPIC_HOME_ADDR);
+#ifdef T6963_STORE
+    // Empty the store by clearing the directory.
+    set_address (GRAPHIC_RING);
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    for (store_top = GRAPHIC_RING; store_top < STORE_HEAP; store_top++)
+        data_write (0);
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+    store_end = VRAM_SIZE;
+#endif
 
     // Next, we need to set the graphics area. This is the length of each
     // line before the line wraps to the next one. Note that it does not have
@@ -562,8 +963,8 @@ t6963_set_pixel (uint8_t x, uint8_t y, uint8_t mode)
 {
     uint8_t xbit = x & 7;               // The sub-column
     
-    // NOTE: There are savings to be made here as we probably do not always
-    // need to set the address as we can write 8-pixels with 1 address set.
+    // Pixels in the same byte as the last access do not load the address as
+    // set_address() knows where the controller is.
 
     // If this is a copy over then simply
     if ((mode & MODE_OP_MASK) == 0)
@@ -609,8 +1010,8 @@ merge_row (uint8_t new_row, uint8_t orig_row, uint8_t mode)
 
     if (mode >= MODE_XOR)
     {
-        // This is XOR or NAND */
-        if ((mode & MODE_XOR) != 0)
+        // This is XOR or NAND, NAND has both the OR and XOR bits set.
+        if (mode == MODE_XOR)
         {
             // MODE_XOR - XOR the existing buffer data with read data.
             new_row ^= orig_row;
@@ -694,26 +1095,37 @@ t6963_read_row (uint8_t x_column, uint8_t y, uint16_t length, uint8_t *buf, uint
     else
     {
         int ii;
+        uint8_t reverse;                // Inverts the data
+
+        // Reverse the data if required.
+        reverse = ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? 0xff : 0x00;
 
         // Perform an auto read to collect the data.
         cmd_write (CMD_DATA_AUTO_READ);
 
-        // Iterate over all of the data
-        for (ii = 0; ii < length; ii++)
+        // Iterate over all of the data. The merge is resolved once for the
+        // row, as merge_row() a merge without an operation is an OR.
+        if ((mode & MODE_MODIFIER) == 0)
         {
-            data = data_read();         // Pick up the data
-
-            // Reverse the data if required.
-            if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
-                data = ~data;
-            
-            // Handle any buffer merging on the read.
-            if ((mode & MODE_MODIFIER) != 0)
-                data = merge_row (buf[ii], data, mode);
-
-            // Assign the data to the buffer.
-            buf[ii] = data;
+            for (ii = 0; ii < length; ii++)
+                buf[ii] = data_read() ^ reverse;
+        }
+        else if ((mode & MODE_OP_MASK) == MODE_XOR)
+        {
+            for (ii = 0; ii < length; ii++)
+                buf[ii] ^= data_read() ^ reverse;
+        }
+        else if ((mode & MODE_OP_MASK) == MODE_NAND)
+        {
+            for (ii = 0; ii < length; ii++)
+                buf[ii] = ~buf[ii] & (data_read() ^ reverse);
         }
+        else
+        {
+            for (ii = 0; ii < length; ii++)
+                buf[ii] |= data_read() ^ reverse;
+        }
+
         // End of auto mode
         cmd_write (CMD_DATA_AUTO_RESET);
     }
@@ -746,22 +1158,17 @@ t6963_write_row (uint8_t x_column, uint8_t y, uint16_t length, uint8_t *buf, uin
     else
     {
         int ii;
+        uint8_t reverse;                // Inverts the data
+
+        // Perform a reverse if required.
+        reverse = ((mode & MODE_NORMAL_MASK) == MODE_REVERSE) ? 0xff : 0x00;
 
         // Perform an auto read to collect the data.
         cmd_write (CMD_DATA_AUTO_WRITE);
 
         // Iterate over all of the data
         for (ii = 0; ii < length; ii++)
-        {
-            uint8_t data = *buf++;
-
-            // Perform a reverse if required.
-            if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
-                data = ~data;
-
-            // Write the data.
-            data_write (data);
-        }
+            data_write (*buf++ ^ reverse);
 
         // End of auto mode
         cmd_write (CMD_DATA_AUTO_RESET);
@@ -988,6 +1395,14 @@ bitblt_line (uint8_t x, uint8_t y, uint8_t width, uint8_t *data, uint8_t mode)
 {
     uint8_t ii;                         // Local iterator
 
+    // Discard lines below the screen so that they do not land in another
+    // part of display memory, and the columns to the right of the screen
+    // that would wrap onto the next row.
+    if ((y >= SCREEN_HEIGHT) || (x >= SCREEN_WIDTH))
+        return;
+    if (width > (uint8_t)(SCREEN_WIDTH - x))
+        width = SCREEN_WIDTH - x;
+
     // See if there is a left merge.
     ii = x & 7;                         // Get the shift on the left
     x >>= 3;                            // Convert to column address
@@ -1123,31 +1538,27 @@ t6963_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode
             if ((length - col) < 8)
                 right_index = right_remain;
 
-            // Read in the data.
-            do
+            // Read in the data to the local buffer prior to conversion, the
+            // source is resolved once for the block.
+            ii = right_index - left_index;
+            if (data == NULL)
+            {
+                // Collect the data from serial.
+                do
+                    fbuf [left_index] = serial_getc ();
+                while (++left_index < right_index);
+            }
+            else if ((mode & MODE_FILL) != 0)
             {
-                uint8_t datum;
-
-                // Write the data data to the buffer
-                if (data == NULL)
-                {
-                    // Collect the data from serial.
-                    datum = serial_getc ();
-                }
-                else
-                {
-                    // Collect the data from the parameter.
-                    datum = *data;
-
-                    // Advance the datum if we are not in fill mode.
-                    if ((mode & MODE_FILL) == 0)
-                        data++;
-                }
-
-                // Save the data in the local buffer prior to conversion
-                fbuf [left_index] = datum;
+                // Fill mode repeats the datum.
+                memset (&fbuf [left_index], *data, ii);
+            }
+            else
+            {
+                // Collect the data from the parameter.
+                memcpy (&fbuf [left_index], data, ii);
+                data += ii;
             }
-            while (++left_index < right_index);
 
             // Flip the data from vertical to horizontal
             flip_8x8_v_to_h (fbuf);
@@ -1178,6 +1589,824 @@ t6963_vbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode
     }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// Horizontal bitblt does a bit transfer of row organised data to display
+/// memory. Each row is (width + 7) / 8 bytes with the most significant bit
+/// on the left, which is the organisation of the display memory, so the
+/// data only has to be shifted to the x position before it is written. If
+/// NULL is passed as data, bitblt takes the data from the serial port.
+///
+/// @param [in] x,y is upper left corner of image in pixels.
+/// @param [in] width The width of the image in pixels.
+/// @param [in] height The height of the image in pixels.
+/// @param [in] mode determines how the bits in the image combine with the
+///             bits already present on the display, see t6963_vbitblt().
+///             MODE_FILL is not supported.
+/// @param [in] data The row data or NULL for serial.
+///
+void
+t6963_hbitblt (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t mode, uint8_t *data)
+{
+    uint8_t row_bytes;                  // The bytes in a row of the image
+    uint8_t shift;                      // The shift to the x position
+
+    row_bytes = (width + 7) >> 3;
+    shift = x & 7;
+
+    // Iterate over all of the rows.
+    while (height-- > 0)
+    {
+        uint8_t carry;                  // The bits shifted out
+        uint8_t ii;                     // General iterator
+
+        // Shift the row to the x position as it is collected, when the
+        // image is column aligned the data passes straight through.
+        carry = 0;
+        for (ii = 0; ii < row_bytes; ii++)
+        {
+            uint8_t datum;
+
+            if (data == NULL)
+                datum = serial_getc ();
+            else
+                datum = *data++;
+
+            draw_buffer [ii] = carry | (datum >> shift);
+            carry = datum << (8 - shift);
+        }
+        draw_buffer [ii] = carry;
+
+        // Write the line.
+        bitblt_line (x, y++, width, draw_buffer, mode);
+    }
+}
+
+#ifdef T6963_STORE
+/////////////////////////////////////////////////////////////////////////////
+/// Read a store directory entry.
+///
+/// @param [in] handle The handle of the block.
+/// @param [out] address The display memory address of the block.
+///
+/// @return The length of the block, zero if the handle is not allocated.
+///
+static uint16_t
+store_entry (uint8_t handle, uint16_t *address)
+{
+    uint16_t length;                    // The length of the block.
+
+    set_address (GRAPHIC_RING + (handle * STORE_ENTRY));
+    cmd_write (CMD_DATA_AUTO_READ);
+    *address = data_read ();
+    *address |= (uint16_t)(data_read ()) << 8;
+    length = data_read ();
+    length |= (uint16_t)(data_read ()) << 8;
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+
+    return length;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Write a store directory entry.
+///
+/// @param [in] handle The handle of the block.
+/// @param [in] address The display memory address of the block.
+/// @param [in] length The length of the block, zero if not allocated.
+///
+static void
+store_set_entry (uint8_t handle, uint16_t address, uint16_t length)
+{
+    set_address (GRAPHIC_RING + (handle * STORE_ENTRY));
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    data_write ((uint8_t)(address & 0xff));
+    data_write ((uint8_t)(address >> 8));
+    data_write ((uint8_t)(length & 0xff));
+    data_write ((uint8_t)(length >> 8));
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Release the block of a store handle.
+///
+/// @param [in] handle The handle of the block to release.
+///
+static void
+store_release (uint8_t handle)
+{
+    uint16_t address;                   // The address of the block.
+    uint16_t length;                    // The length of the block.
+
+    if ((length = store_entry (handle, &address)) != 0)
+    {
+        // Give the space back immediately if this is the top block,
+        // otherwise it is recovered when the heap is compacted.
+        if (address + length == store_top)
+            store_top = address;
+        store_set_entry (handle, 0, 0);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Compact the store heap. The live blocks are moved down to the bottom of
+/// the heap in address order removing the space of any released blocks.
+///
+static void
+store_compact (void)
+{
+    uint16_t top;                       // The top of the compacted heap.
+
+    for (top = STORE_HEAP; /* Forever */; )
+    {
+        uint16_t lowest;                // The lowest block address.
+        uint16_t lowest_length;         // The length of the lowest block.
+        uint8_t lowest_handle;          // The handle of the lowest block.
+        uint8_t handle;
+
+        // Find the lowest block that has not been moved.
+        lowest = VRAM_SIZE;
+        lowest_length = 0;
+        lowest_handle = 0;
+        for (handle = 0; handle < STORE_HANDLES; handle++)
+        {
+            uint16_t address;
+            uint16_t length;
+
+            length = store_entry (handle, &address);
+            if ((length != 0) && (address >= top) && (address < lowest))
+            {
+                lowest = address;
+                lowest_length = length;
+                lowest_handle = handle;
+            }
+        }
+
+        // Finished when all of the blocks have been moved.
+        if (lowest_length == 0)
+            break;
+
+        // Move the block down over the free space.
+        if (lowest != top)
+        {
+            copy_block (lowest, top, lowest_length, draw_buffer);
+            store_set_entry (lowest_handle, top, lowest_length);
+        }
+        top += lowest_length;
+    }
+    store_top = top;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Allocate a block in the store. Any existing block of the handle is
+/// released first.
+///
+/// @param [in] handle The handle of the block.
+/// @param [in] length The length of the block.
+///
+/// @return The display memory address of the block, zero if there is no
+///         space.
+///
+static uint16_t
+store_alloc (uint8_t handle, uint16_t length)
+{
+    uint16_t address;                   // The address of the block.
+
+    store_release (handle);
+
+    // Recover any released space if the block does not fit.
+    if (store_top + length > store_end)
+    {
+        store_compact ();
+        if (store_top + length > store_end)
+            return 0;
+    }
+
+    address = store_top;
+    store_top += length;
+    store_set_entry (handle, address, length);
+    return address;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Upload a VRAM sprite. The command collects the data from the serial in
+/// the native bitblt format and stores it in display memory as rows so that
+/// it may be drawn without conversion. The sprite is held as
+/// [width][height][rows] and a row is (width + 7) / 8 bytes.
+///
+/// A sprite with no width or height is deleted. The data of a sprite that
+/// is too large or that does not fit into the store is discarded.
+///
+/// @param [in] sprite_id The identity of the sprite 0..VRAM_SPRITE_NUM-1.
+/// @param [in] width The width of the sprite in bits.
+/// @param [in] height The height of the sprite in bits.
+///
+void
+t6963_sprite_upload (uint8_t sprite_id, uint8_t width, uint8_t height)
+{
+    uint16_t address;                   // The address of the sprite.
+    uint8_t row_bytes;                  // The bytes in a row.
+    uint8_t row;                        // The current row being processed.
+
+    // Allocate the sprite. A band of rows is converted in the draw_buffer
+    // which limits the width to the screen width.
+    row_bytes = (width + 7) >> 3;
+    address = 0;
+    if ((width == 0) || (height == 0))
+        store_release (sprite_id);
+    else if ((width <= SCREEN_WIDTH) && (height <= SCREEN_HEIGHT))
+        address = store_alloc (sprite_id, 2 + (height * row_bytes));
+
+    // Discard the data of a sprite that is not stored.
+    if (address == 0)
+    {
+        uint16_t length;                // The bytes of sprite data.
+
+        for (length = width * ((height + 7) >> 3); length > 0; length--)
+            serial_getc ();
+        return;
+    }
+
+    // Write the sprite dimensions.
+    set_address (address);
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    data_write (width);
+    data_write (height);
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+    address += 2;
+
+    // Iterate over the bands of 8 rows.
+    for (row = 0; row < height; row += 8)
+    {
+        uint8_t length;                 // The bytes in the band.
+        uint8_t col;                    // The current column being processed.
+        uint8_t ii;                     // General iterator
+
+        // Convert the band from vertical to horizontal.
+        for (col = 0; col < width; col += 8)
+        {
+            uint8_t buf_index;
+            uint8_t fbuf [8];
+
+            for (ii = 0; ii < 8; ii++)
+                fbuf [ii] = (col + ii < width) ? serial_getc () : 0;
+
+            // Flip the data from vertical to horizontal
+            flip_8x8_v_to_h (fbuf);
+
+            // Organise the rows a row width apart.
+            buf_index = col >> 3;
+            for (ii = 0; ii < 8; ii++)
+            {
+                draw_buffer [buf_index] = fbuf[ii];
+                buf_index += row_bytes;
+            }
+        }
+
+        // Write out the rows of the band.
+        length = height - row;
+        if (length > 8)
+            length = 8;
+        length *= row_bytes;
+        set_address (address);
+        cmd_write (CMD_DATA_AUTO_WRITE);
+        for (ii = 0; ii < length; ii++)
+            data_write (draw_buffer [ii]);
+        cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+        address += length;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draws a VRAM sprite at (x,y) using mode. The rows of the sprite are read
+/// from the store with auto read and written to the screen a row at a time.
+///
+/// @param [in] x is the first x-coordinate to start drawing.
+/// @param [in] y is the first y-coordinate to start drawing.
+/// @param [in] sprite_id identifies the sprite to draw 0..VRAM_SPRITE_NUM-1.
+/// @param [in] mode The drawing mode.
+///
+void
+t6963_sprite_draw (uint8_t x, uint8_t y, uint8_t sprite_id, uint8_t mode)
+{
+    uint16_t address;                   // The address of the sprite.
+    uint8_t width;                      // Sprite width
+    uint8_t height;                     // Sprite height
+    uint8_t row_bytes;                  // The bytes in a row.
+    uint8_t shift;                      // The bit shift of the rows.
+    uint8_t rows;                       // The rows read at a time.
+    // The rows are read into the start of the draw_buffer and each row is
+    // shifted into position at the end.
+    uint8_t *line = (draw_buffer + 128);
+
+    // Ignore a sprite that has not been uploaded.
+    if (store_entry (sprite_id, &address) == 0)
+        return;
+
+    // Read the sprite dimensions.
+    set_address (address);
+    cmd_write (CMD_DATA_AUTO_READ);
+    width = data_read ();
+    height = data_read ();
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+    address += 2;
+
+    // If the mode is centre then centre the sprite at the x,y corrdinates.
+    if (mode & MODE_SPRITE_CENTER)
+    {
+        if (x > (width >> 1))
+            x -= width >> 1;
+        if (y > (height >> 1))
+            y -= height >> 1;
+    }
+
+    // Resolve the mode as draw_vbitblt().
+    mode = ((~mode ^ prefs_reverse) & MODE_NORMAL_MASK) |
+        (mode & ~(MODE_LINE_MASK|MODE_SPRITE_CENTER|MODE_NORMAL_MASK));
+
+    row_bytes = (width + 7) >> 3;
+    shift = x & 7;
+    rows = 128 / row_bytes;
+
+    // The rows are read whole but only the columns on the screen are
+    // written, x may be anywhere up to 255 after the origin is applied.
+    if (x >= SCREEN_WIDTH)
+        return;
+    if (width > (uint8_t)(SCREEN_WIDTH - x))
+        width = SCREEN_WIDTH - x;
+
+    // Iterate over the rows that are on the screen.
+    while ((height > 0) && (y < SCREEN_HEIGHT))
+    {
+        uint8_t length;                 // The bytes read.
+        uint8_t *data;                  // The current row.
+        uint8_t ii;                     // General iterator
+
+        if (rows > height)
+            rows = height;
+        height -= rows;
+
+        // Read in a block of rows.
+        length = rows * row_bytes;
+        set_address (address);
+        cmd_write (CMD_DATA_AUTO_READ);
+        for (ii = 0; ii < length; ii++)
+            draw_buffer [ii] = data_read ();
+        cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+        address += length;
+
+        // Write each row shifted to the x position.
+        for (data = draw_buffer; data < draw_buffer + length; data += row_bytes)
+        {
+            uint8_t carry;              // The bits shifted out
+
+            carry = 0;
+            for (ii = 0; ii < row_bytes; ii++)
+            {
+                line [ii] = carry | (data [ii] >> shift);
+                carry = data [ii] << (8 - shift);
+            }
+            line [ii] = carry;
+
+            bitblt_line (x, y++, width, line, mode);
+        }
+    }
+}
+#endif /* T6963_STORE */
+
+#if defined(T6963_STORE) || defined(FONT_WINDOW)
+/////////////////////////////////////////////////////////////////////////////
+/// Write a row of a rectangle, merging the pixels outside of the rectangle
+/// in the partial columns at the edges.
+///
+/// @param [in] col The first column.
+/// @param [in] y The row to write.
+/// @param [in] cols The number of columns.
+/// @param [in] data The columns to write.
+/// @param [in] left_mask The valid bits of the first column.
+/// @param [in] right_mask The valid bits of the last column.
+///
+static void
+write_row_masked (uint8_t col, uint8_t y, uint8_t cols, uint8_t *data,
+                  uint8_t left_mask, uint8_t right_mask)
+{
+    uint8_t first;                      // The first whole column.
+    uint8_t last;                       // The column after the last whole.
+
+    first = 0;
+    last = cols;
+    if (left_mask != 0xff)
+    {
+        t6963_set_row (col, y, data [0], left_mask, MODE_COPY|MODE_MERGE);
+        first++;
+    }
+    if ((cols > 1) && (right_mask != 0xff))
+    {
+        last--;
+        t6963_set_row (col + last, y, data [last], right_mask, MODE_COPY|MODE_MERGE);
+    }
+    if (last > first)
+        t6963_write_row (col + first, y, last - first, &data [first], MODE_COPY);
+}
+#endif
+
+#ifdef FONT_WINDOW
+/////////////////////////////////////////////////////////////////////////////
+/// Scroll a window of the display up. The graphic home moves the whole
+/// screen so the rows of the window are copied instead, each row is read
+/// with an auto read and written back with an auto write with the pixels
+/// outside of the window merged in the edge columns. The lines that scroll
+/// into the bottom of the window are cleared. The text layer is not
+/// scrolled.
+///
+/// @param [in] x0 The left x-coordinate of the window.
+/// @param [in] y0 The top y-coordinate of the window.
+/// @param [in] x1 The right x-coordinate of the window.
+/// @param [in] y1 The bottom y-coordinate of the window.
+/// @param [in] pixels The number of pixels to scroll up.
+/// @param [in] mode The current mode.
+///
+void
+t6963_wscroll (uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t pixels, uint8_t mode)
+{
+    uint8_t col;                        // The first column.
+    uint8_t cols;                       // The number of columns.
+    uint8_t left_mask;                  // The valid bits of the first column.
+    uint8_t right_mask;                 // The valid bits of the last column.
+    uint8_t yy;                         // The row.
+
+    // Nothing to do.
+    if (pixels == 0)
+        return;
+
+    // Compute the masks of the pixels in the edge columns.
+    col = x0 >> 3;
+    cols = (x1 >> 3) - col + 1;
+    left_mask = pgm_read_byte (&bit_shift_maskP[x0 & 7]);
+    right_mask = (uint8_t)(0xff80 >> (x1 & 7));
+    if (cols == 1)
+        left_mask &= right_mask;
+
+    // Determine if the screen is reversed or not. In normal mode we write
+    // 0x00 when reversed we write 0xff. Note: 0x00-0x01 = 0xff !!
+    mode = (mode & MODE_NORMAL_MASK) - 1;
+
+    for (yy = y0; yy <= y1; yy++)
+    {
+        // Copy the row from below or clear it.
+        if (pixels <= (uint8_t)(y1 - yy))
+            t6963_read_row (col, yy + pixels, cols, draw_buffer, MODE_COPY);
+        else
+            memset (draw_buffer, mode, cols);
+        write_row_masked (col, yy, cols, draw_buffer, left_mask, right_mask);
+    }
+}
+#endif /* FONT_WINDOW */
+
+/////////////////////////////////////////////////////////////////////////////
+/// Copy a rectangle of the display to another position. Each row of the
+/// source is read with an auto read into the draw_buffer, shifted to the x
+/// position of the destination and written back as a bitblt line with the
+/// pixels outside of the rectangle merged in the edge columns. The rows are
+/// copied from the bottom up when moving down so that the rectangles may
+/// overlap.
+///
+/// @param [in] sx The left x-coordinate of the source.
+/// @param [in] sy The top y-coordinate of the source.
+/// @param [in] width The width of the rectangle in pixels.
+/// @param [in] height The height of the rectangle in pixels.
+/// @param [in] dx The left x-coordinate of the destination.
+/// @param [in] dy The top y-coordinate of the destination.
+/// @param [in] mode The merging mode of the copy.
+///
+void
+t6963_copy_rect (uint8_t sx, uint8_t sy, uint8_t width, uint8_t height,
+                 uint8_t dx, uint8_t dy, uint8_t mode)
+{
+    uint8_t *row = &draw_buffer [SCREEN_COLUMNS + 2]; // The source row
+    uint8_t *source;                    // The source of the first column
+    uint8_t col;                        // The first source column.
+    uint8_t cols;                       // The number of source columns.
+    uint8_t bytes;                      // The number of destination columns.
+    uint8_t shift;                      // The shift to the x position.
+    uint8_t yy;                         // The row of the rectangle.
+
+    // Compute the columns of the source and destination. The source is
+    // shifted right by the difference of the x positions, a shift left is
+    // a shift right from the next column.
+    col = sx >> 3;
+    cols = ((sx + width - 1) >> 3) - col + 1;
+    bytes = ((dx & 7) + width + 7) >> 3;
+    shift = ((dx & 7) - (sx & 7)) & 7;
+    source = &row [((dx & 7) < (sx & 7)) ? 2 : 1];
+    row [0] = 0;
+
+    for (yy = 0; yy < height; yy++)
+    {
+        uint8_t y;                      // The row offset being copied.
+        uint8_t ii;
+
+        y = (dy > sy) ? (height - 1 - yy) : yy;
+
+        // Read the source row and shift it into the draw_buffer.
+        t6963_read_row (col, sy + y, cols, &row [1], mode & MODE_NORMAL_MASK);
+        for (ii = 0; ii < bytes; ii++)
+            draw_buffer [ii] = (source [ii - 1] << (8 - shift)) | (source [ii] >> shift);
+
+        // Write the line.
+        bitblt_line (dx, dy + y, width, draw_buffer, mode);
+    }
+}
+
+#ifdef T6963_STORE
+/////////////////////////////////////////////////////////////////////////////
+/// Save a rectangle of the screen to a slot in the store. The rectangle is
+/// saved as whole columns with [x1][y1][x2][y2] so that it may be restored
+/// to the same place. Any previous contents of the slot are released.
+///
+/// @param [in] slot The slot to save to 0..SCREEN_SLOT_NUM-1.
+/// @param [in] x1 The left x-coordinate.
+/// @param [in] y1 The top y-coordinate.
+/// @param [in] x2 The right x-coordinate.
+/// @param [in] y2 The bottom y-coordinate.
+///
+void
+t6963_screen_save (uint8_t slot, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+{
+    uint16_t address;                   // The address of the slot.
+    uint8_t col;                        // The first column.
+    uint8_t cols;                       // The number of columns.
+    uint8_t rows;                       // The rows copied at a time.
+
+    // Only the T6963 has the display memory for slots.
+    if (!is_large() || (slot >= SCREEN_SLOT_NUM))
+        return;
+
+    // Order the coordinates and clip to the screen.
+    if (x1 > x2)
+        swap_bytes (x1, x2);
+    if (y1 > y2)
+        swap_bytes (y1, y2);
+    if (x2 >= SCREEN_WIDTH)
+        x2 = SCREEN_WIDTH - 1;
+    if (y2 >= SCREEN_HEIGHT)
+        y2 = SCREEN_HEIGHT - 1;
+    if ((x1 > x2) || (y1 > y2))
+        return;
+
+    col = x1 >> 3;
+    cols = (x2 >> 3) - col + 1;
+    address = store_alloc (STORE_SLOT + slot, 4 + ((y2 - y1 + 1) * cols));
+    if (address == 0)
+        return;
+
+    // Write the rectangle.
+    set_address (address);
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    data_write (x1);
+    data_write (y1);
+    data_write (x2);
+    data_write (y2);
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+    address += 4;
+
+    // Copy blocks of rows through the draw_buffer.
+    rows = sizeof (draw_buffer) / cols;
+    y2++;
+    while (y1 < y2)
+    {
+        uint8_t length;                 // The bytes in the block.
+        uint8_t ii;                     // General iterator
+
+        if (rows > y2 - y1)
+            rows = y2 - y1;
+
+        // Read in the rows.
+        length = 0;
+        for (ii = 0; ii < rows; ii++)
+        {
+            t6963_read_row (col, y1++, cols, &draw_buffer [length], MODE_COPY);
+            length += cols;
+        }
+
+        // Write the rows to the slot.
+        set_address (address);
+        cmd_write (CMD_DATA_AUTO_WRITE);
+        for (ii = 0; ii < length; ii++)
+            data_write (draw_buffer [ii]);
+        cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+        address += length;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Restore a saved rectangle of the screen from a slot in the store. Only
+/// the pixels of the saved rectangle are written.
+///
+/// @param [in] slot The slot to restore from 0..SCREEN_SLOT_NUM-1.
+/// @param [in] flags SCREEN_RESTORE_RELEASE to release the slot after the
+///                   restore.
+///
+void
+t6963_screen_restore (uint8_t slot, uint8_t flags)
+{
+    uint16_t address;                   // The address of the slot.
+    uint8_t x1, y1, x2, y2;             // The rectangle.
+    uint8_t col;                        // The first column.
+    uint8_t cols;                       // The number of columns.
+    uint8_t rows;                       // The rows copied at a time.
+    uint8_t left_mask;                  // The valid bits of the first column.
+    uint8_t right_mask;                 // The valid bits of the last column.
+
+    // Ignore a slot that has not been saved.
+    if (!is_large() || (slot >= SCREEN_SLOT_NUM) ||
+        (store_entry (STORE_SLOT + slot, &address) == 0))
+        return;
+
+    // Read the rectangle.
+    set_address (address);
+    cmd_write (CMD_DATA_AUTO_READ);
+    x1 = data_read ();
+    y1 = data_read ();
+    x2 = data_read ();
+    y2 = data_read ();
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+    address += 4;
+
+    // Compute the masks of the pixels in the edge columns.
+    col = x1 >> 3;
+    cols = (x2 >> 3) - col + 1;
+    left_mask = pgm_read_byte (&bit_shift_maskP[x1 & 7]);
+    right_mask = (uint8_t)(0xff80 >> (x2 & 7));
+    if (cols == 1)
+        left_mask &= right_mask;
+
+    // Copy blocks of rows through the draw_buffer.
+    rows = sizeof (draw_buffer) / cols;
+    y2++;
+    while (y1 < y2)
+    {
+        uint8_t length;                 // The bytes in the block.
+        uint8_t *data;                  // The current row.
+        uint8_t ii;                     // General iterator
+
+        if (rows > y2 - y1)
+            rows = y2 - y1;
+
+        // Read in the rows from the slot.
+        length = rows * cols;
+        set_address (address);
+        cmd_write (CMD_DATA_AUTO_READ);
+        for (ii = 0; ii < length; ii++)
+            draw_buffer [ii] = data_read ();
+        cmd_write (CMD_DATA_AUTO_RESET);  // End of auto mode.
+        address += length;
+
+        // Write each row, merging the partial columns at the edges.
+        for (data = draw_buffer; data < draw_buffer + length; data += cols)
+            write_row_masked (col, y1++, cols, data, left_mask, right_mask);
+    }
+
+    // Give the space back to the store.
+    if ((flags & SCREEN_RESTORE_RELEASE) != 0)
+        store_release (STORE_SLOT + slot);
+}
+#endif /* T6963_STORE */
+
+#ifdef T6963_TEXT_LAYER
+/////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the hardware text layer. The text layer is displayed
+/// over the graphics with the characters XORed onto the graphics or, in
+/// attribute mode, on its own with per character attributes. Enabling the
+/// text layer requires the top 2K of the store to be free.
+///
+/// @param [in] flags TEXT_LAYER_ON to enable the text layer with the
+///                   TEXT_LAYER_ATTRIBUTE and TEXT_LAYER_BLINK options, zero
+///                   to disable.
+///
+/// @return The flags in effect, zero if the text layer is off.
+///
+uint8_t
+t6963_text_layer (uint8_t flags)
+{
+    // Only the T6963 has a text layer.
+    if (!is_large())
+        return 0;
+
+    if ((flags & TEXT_LAYER_ON) == 0)
+    {
+        // Return to graphics only, the text layer memory is given back to
+        // the store.
+        text_layer = 0;
+#ifdef T6963_STORE
+        store_end = VRAM_SIZE;
+#endif
+        cmd_write (CMD_MODE_SET);
+        cmd_write (CMD_DISPLAY_GRAPHIC);
+    }
+    else
+    {
+        if (text_layer == 0)
+        {
+#ifdef T6963_STORE
+            // Make sure that the store does not use the text layer memory.
+            store_compact ();
+            if (store_top > TEXT_CG)
+                return 0;
+            store_end = TEXT_CG;
+#endif
+
+            // Set up the text area and the CG RAM location.
+            data_write ((uint8_t)(TEXT_HOME & 0xff));
+            data_write ((uint8_t)(TEXT_HOME >> 8));
+            cmd_write (CMD_SET_TEXT_HOME_ADDR);
+            data_write (TEXT_COLUMNS);
+            data_write (0);
+            cmd_write (CMD_SET_TEXT_AREA);
+            data_write (TEXT_OFFSET);
+            data_write (0);
+            cmd_write (CMD_SET_OFFSET_REGISTER);
+            text_clear (~prefs_reverse);
+        }
+
+        // Characters come from CG RAM and are either XORed with the
+        // graphics or take their attributes from the graphic area.
+        text_layer = flags;
+        if ((flags & TEXT_LAYER_ATTRIBUTE) != 0)
+            cmd_write (CMD_EXTERNAL_CG_ROM_MODE | CMD_TEXT_ATTRIBUTE_MODE);
+        else
+            cmd_write (CMD_EXTERNAL_CG_ROM_MODE | CMD_MODE_EXOR);
+        cmd_write (CMD_TEXT_GRAPHIC);
+    }
+
+    // Point the graphic home at the graphics or the attributes.
+    set_graphic_home (graphic_home);
+    return text_layer;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Load a character into the CG RAM of the text layer.
+///
+/// @param [in] code The character code 0..95, the character less 0x20.
+/// @param [in] buf The 8 columns of the character in bitblt format, this is
+///                 used as the work buffer.
+///
+void
+t6963_text_glyph (uint8_t code, uint8_t *buf)
+{
+    uint8_t ii;
+
+    // Flip the data from vertical to horizontal
+    flip_8x8_v_to_h (buf);
+
+    set_address (TEXT_CG + (code * 8));
+    cmd_write (CMD_DATA_AUTO_WRITE);
+    for (ii = 0; ii < 8; ii++)
+        data_write (buf [ii]);
+    cmd_write (CMD_DATA_AUTO_RESET);    // End of auto mode.
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Draw a character on the text layer. The character occupies the 8x8 cell
+/// that contains x,y.
+///
+/// @param [in] x The x-coordinate of the character.
+/// @param [in] y The y-coordinate of the character.
+/// @param [in] code The character code 0..95, the character less 0x20.
+/// @param [in] mode The drawing mode, in attribute mode the character is
+///                  reversed when the mode is MODE_REVERSE.
+///
+void
+t6963_text_draw (uint8_t x, uint8_t y, uint8_t code, uint8_t mode)
+{
+    uint16_t offset;                    // The offset of the cell.
+
+    if ((x >= SCREEN_WIDTH) || (y >= SCREEN_HEIGHT))
+        return;
+    offset = ((y >> 3) * TEXT_COLUMNS) + (x >> 3);
+
+    // Write the character and move on, the next character is usually in
+    // the next cell.
+    set_address (TEXT_HOME + offset);
+    data_write (code);
+    cmd_write (CMD_DATA_WRITE_INC);
+    address_pointer++;
+
+    // Write the attribute.
+    if ((text_layer & TEXT_LAYER_ATTRIBUTE) != 0)
+    {
+        code = 0;
+        if ((mode & MODE_NORMAL_MASK) == MODE_REVERSE)
+            code = TEXT_ATTR_REVERSE;
+        if ((text_layer & TEXT_LAYER_BLINK) != 0)
+            code |= TEXT_ATTR_BLINK;
+
+        set_address (TEXT_ATTR + offset);
+        data_write (code);
+        cmd_write (CMD_DATA_WRITE_INC);
+        address_pointer++;
+    }
+}
+#endif /* T6963_TEXT_LAYER */
+
 /////////////////////////////////////////////////////////////////////////////
 /// Draw a horizontal line
 ///